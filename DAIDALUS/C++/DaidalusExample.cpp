@@ -91,21 +91,17 @@ void printBands(KinematicBands& bands) {
 }
 
 void printBlobs(Daidalus& daa) {
+	ViolationContour contour;
 	// Aircraft at index 0 is ownship
 	for (int ac=1; ac < daa.numberOfAircraft(); ac++) {
-		OwnshipState own = daa.getOwnshipState();
-		Position po = own.getPosition();
-		Velocity vo = own.getVelocity();
-		TrafficState intruder = daa.getTrafficState(ac);
-		Position pi = intruder.getPosition();
-		Velocity vi = intruder.getVelocity();
-		for (double trk = 0; trk < 360; ++trk) {
-			Velocity vop = vo.mkTrk(trk,"deg");
-			LossData los = daa.getDetector()->conflictDetection(own.get_s(),own.vel_to_v(po,vop),
-					own.pos_to_s(pi), own.vel_to_v(pi,vi), 0, daa.getLookaheadTime());
-			if (los.conflict()) {
-				std::cout << "Draw a line from " << po.linear(vop,los.getTimeIn()).toString() << 
-						" to " << po.linear(vop,los.getTimeOut()).toString() << std::endl;
+		daa.violationContour(ac,contour);
+		for (int i=0; i < contour.size(); ++i) {
+			// Each sampled track of a region is drawn as a line from the entry to the exit of the violation volume
+			const std::vector<Position>& entries = contour.getEntries(i);
+			const std::vector<Position>& exits = contour.getExits(i);
+			for (int k=0; k < (int) entries.size(); ++k) {
+				std::cout << "Draw a line from " << entries[k].toString() <<
+						" to " << exits[k].toString() << std::endl;
 			}
 		}
 	}
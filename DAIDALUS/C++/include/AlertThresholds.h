@@ -9,6 +9,7 @@
 
 #include "Detection3D.h"
 #include "CDCylinder.h"
+#include "ConflictData.h"
 #include "Vect3.h"
 #include "Velocity.h"
 #include <string>
@@ -48,6 +49,12 @@ public:
 
   std::pair<bool, double> alerting(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi) const;
 
+  /**
+   * Alerting status for the result det of the conflict detection of this object's detector in the
+   * interval [0,alerting_time].
+   */
+  std::pair<bool, double> alerting(const ConflictData& det) const;
+
   std::string toString() const;
 
 };
@@ -56,6 +56,7 @@
 #include "CD3DTable.h"
 #include "LossData.h"
 #include "ConflictData.h"
+#include "TrafficArrays.h"
 
 namespace larcfm {
 
@@ -161,6 +162,12 @@ namespace larcfm {
     virtual bool conflict(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
     virtual ConflictData conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
+    virtual bool anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const;
+    virtual bool anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const;
+
+    virtual double horizontalViolationBound(double vh) const;
+    virtual double verticalViolationBound(double vz) const;
+
     /** This returns a pointer to a new instance of this type of Detector3D.  You are responsible for destroying this instance when it is no longer needed. */
     virtual CDCylinder* copy() const;
     virtual CDCylinder* make() const;
@@ -169,6 +176,8 @@ namespace larcfm {
     virtual void setParameters(const ParameterData& p);
 
     virtual std::string getSimpleClassName() const;
+    virtual int getClassTag() const;
+    virtual int getSuperClassTag() const;
   
     virtual std::string toString() const;
 
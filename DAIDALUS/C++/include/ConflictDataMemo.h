@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef CONFLICTDATAMEMO_H_
+#define CONFLICTDATAMEMO_H_
+
+#include "Detection3D.h"
+#include "ConflictData.h"
+#include <map>
+
+namespace larcfm {
+
+/**
+ * Table of conflict detection results, indexed by aircraft index, detector, and time interval [B,T] of the
+ * detection, for the aircraft states projected at one time. Storing a result for another time removes the
+ * results of the previous time, so that the table does not grow with the number of query times. The table
+ * does not check that the states and detectors are the same as when the results were stored. Therefore,
+ * it must be cleared whenever an aircraft state, a detector, or a detector parameter changes, and whenever
+ * a detector is deleted, since its address may be reused by another detector.
+ */
+class ConflictDataMemo {
+
+private:
+  class Key {
+  public:
+    int ac;
+    const Detection3D* detector;
+    double B;
+    double T;
+    Key(int ac, const Detection3D* detector, double B, double T);
+    bool operator<(const Key& k) const;
+  };
+
+  std::map<Key,ConflictData> table;
+  double time;
+
+public:
+
+  ConflictDataMemo();
+
+  /**
+   * Returns true and sets data to the result stored for the given key, if any.
+   */
+  bool lookup(int ac, const Detection3D* detector, double time, double B, double T, ConflictData& data) const;
+
+  void store(int ac, const Detection3D* detector, double time, double B, double T, const ConflictData& data);
+
+  void clear();
+
+  int size() const;
+
+};
+
+}
+
+#endif
@@ -14,6 +14,12 @@
 #include "AlertThresholds.h"
 #include "AlertInfo.h"
 #include "KinematicBands.h"
+#include "DaidalusResult.h"
+#include "ThreadPool.h"
+#include "ConflictDataMemo.h"
+#include "ViolationContour.h"
+#include "ProbeResult.h"
+#include "TrafficArrays.h"
 #include <string>
 #include <vector>
 
@@ -35,6 +41,7 @@ private:
   std::vector<AlertThresholds> alertor;
   AlertInfo info;
   Detection3D* detector; // State-based detector
+  std::string detector_class; // Canonical class name of detector, kept for messages
   UrgencyStrategy* urgency_strat; // Strategy for most urgent aircraft
   DaidalusParameters parameters;
   void set_detector_from_parameters();
@@ -47,6 +54,21 @@ private:
 
   mutable ErrorLog error;
 
+  int pruned_aircraft; // Number of aircraft dropped by the reachability filter of thresholds alerting
+
+  /* Conflict detection results of the current aircraft states, detectors, and alert thresholds. It is
+   * cleared by every method that changes any of them, and by getDetector, since the detector may be
+   * changed through the returned pointer. */
+  mutable ConflictDataMemo memo;
+
+  /**
+   * Returns the result of the conflict detection of detector between the ownship own and the aircraft aci,
+   * whose states are the ones of the aircraft at index ac projected at given time. The result is
+   * only computed once for the current aircraft states and detectors.
+   */
+  ConflictData conflict_detection(int ac, double time, const Detection3D* det, const OwnshipState& own, const TrafficState& aci,
+      double B, double T);
+
 public:
 
   /**
@@ -85,7 +107,11 @@ public:
   void reset();
 
   /**
-   * @return a reference to this object's Detectoin3D instance.
+   * @return a reference to this object's Detectoin3D instance. Detection results are reused until
+   * the aircraft states or the detector change through this object. Since the detector may be changed
+   * through the returned reference, the stored results are discarded by each call to this method. A
+   * reference kept after other methods of this object are called should not be used to change the
+   * detector: get the reference again, or call setDetector.
    */
   Detection3D* getDetector() const;
 
@@ -94,6 +120,14 @@ public:
    */
   void setDetector(const Detection3D* d);
 
+  /**
+   * Set this object's Detection3D method to be a new instance of the given class, as registered in
+   * Detection3DRegistry. The class name may be canonical or simple, e.g., "WCV_TCPA". The detector is
+   * configured with the thresholds of this object's parameters.
+   * @return true if the class is registered, otherwise the detector is not changed.
+   */
+  bool setDetector(const std::string& classname);
+
   static std::vector<AlertThresholds> PT5();
   static std::vector<AlertThresholds> MOPS();
 
@@ -222,13 +256,20 @@ public:
 
   AlertInfo lastAlertInfo() const;
 
+  /**
+   * @return number of times that thresholds alerting has found an aircraft not alerting without calling
+   * any detector, because it cannot be in conflict with the ownship within the alerting time of any
+   * set of alert thresholds.
+   */
+  int prunedAircraftCount() const;
+
 private:
 
   /** 
    * Computes alert type for given aircraft states using different set of threshold values. 
    * @return 0 if no alert thresholds are violated.
    */
-  int thresholds_alerting(const OwnshipState& own, const TrafficState& ac);
+  int thresholds_alerting(int ac, double time, const OwnshipState& own, const TrafficState& aci);
 
   double last_time_to_maneuver(const OwnshipState& own, const TrafficState& ac, const TrafficState& repac, double t2v);
 
@@ -236,7 +277,7 @@ private:
    * Computes alert type for given aircraft states using different kinematic bands. 
    * @return 0 if no alert thresholds are violated.
    */
-  int bands_alerting(const OwnshipState& own, const TrafficState& ac, const TrafficState& repac);
+  int bands_alerting(int ac, double time, const OwnshipState& own, const TrafficState& aci, const TrafficState& repac);
 
 public:
 
@@ -286,6 +327,42 @@ public:
    */
   double timeToViolation(int ac);
 
+  /**
+   * Computes the time intervals of violation between ownship and every aircraft, where states are projected
+   * at given time, for lookahead time. The ownship is projected once for all aircraft. On return, data has
+   * one element per aircraft and data[ac] is the result of timeIntervalOfViolationAt(ac,time); data[0]
+   * corresponds to the ownship and has no conflict. The storage of data is reused across calls. Returns false,
+   * and clears data, if time is not valid or no aircraft information has been loaded.
+   */
+  bool timeIntervalsOfViolationAt(double time, std::vector<ConflictData>& data);
+
+  /**
+   * Same as timeIntervalsOfViolationAt for current time.
+   */
+  bool timeIntervalsOfViolation(std::vector<ConflictData>& data);
+
+  /**
+   * Computes the times [s] to violation between ownship and every aircraft, where states are projected at
+   * given time, for the lookahead time. On return, t2v has one element per aircraft and t2v[ac] is the result
+   * of timeToViolationAt(ac,time); t2v[0] corresponds to the ownship and is negative. The storage of t2v is
+   * reused across calls. Returns false, and clears t2v, if time is not valid or no aircraft information has
+   * been loaded.
+   */
+  bool timesToViolationAt(double time, std::vector<double>& t2v);
+
+  /**
+   * Same as timesToViolationAt for current time.
+   */
+  bool timesToViolation(std::vector<double>& t2v);
+
+  /**
+   * Computes the violation contour of ownship and aircraft at index ac for current aircraft states and
+   * lookahead time: the regions of ownship tracks that lead to a conflict with the aircraft, and the positions
+   * where the ownship enters and exits violation for sampled tracks of these regions. The accuracy of the contour
+   * is given by the tolerances of contour. Returns false, and clears contour, if the aircraft index is not valid.
+   */
+  bool violationContour(int ac, ViolationContour& contour);
+
   /**
    * @return kinematic bands at given time. Computation of bands is lazy, they are only compute when needed.
    * @param time - The time the bands will be calculated for. This must be a time within the ownship's Plan [s]
@@ -309,6 +386,48 @@ public:
    */
   KinematicBands getKinematicBands();
 
+  /**
+   * Computes alerts and kinematic bands for each aircraft at the given indices, when this aircraft
+   * is considered the ownship and all the other aircraft are traffic. All aircraft are evaluated at
+   * current time. Therefore, the result for an aircraft at index i may differ from the one obtained after
+   * resetOwnship(i) when the aircraft states were given at different times. When pool is not NULL,
+   * the aircraft are evaluated in parallel. The pool is not owned by this object.
+   * @return one result per valid index, in the same order as the indices.
+   */
+  std::vector<DaidalusResult> getResults(const std::vector<int>& indices, ThreadPool* pool);
+
+  /**
+   * Computes alerts and kinematic bands for every aircraft, when this aircraft is considered
+   * the ownship and all the other aircraft are traffic. See getResults(indices,pool).
+   */
+  std::vector<DaidalusResult> getAllResults(ThreadPool* pool);
+
+  /**
+   * Probes candidate ownship velocities against all the traffic aircraft at current time, for lookahead time.
+   * Candidate velocities are ground velocities, as the velocities given to setOwnshipState. On return, results has one element per candidate velocity and results[k] is the conflict status, the
+   * earliest time of violation, and the indices of the aircraft in conflict, when the ownship flies
+   * velocities[k]. The storage of results is reused across calls. Candidates and aircraft are checked in
+   * tiles, so that the states of a block of aircraft are reused by several candidates while they are in cache.
+   * When pool is not NULL, tiles of candidates are evaluated in parallel. The pool is not owned by this object.
+   * Returns false, and clears results, if no aircraft information has been loaded.
+   */
+  bool probeVelocities(const std::vector<Velocity>& velocities, std::vector<ProbeResult>& results, ThreadPool* pool);
+
+private:
+  void ownship_result(int i, DaidalusResult& result) const;
+
+  /** Number of candidate velocities in a tile of probeVelocities */
+  static const int PROBE_TILE = 16;
+
+  /**
+   * Sets results[k], for k in [k0,k1), to the result of probing the projected ownship velocity vos[k], from
+   * position so, against traffic. Traffic is checked in blocks of TrafficArrays::BLOCK aircraft.
+   */
+  void probe_tile(const Vect3& so, const std::vector<Velocity>& vos, const TrafficArrays& traffic, int k0, int k1,
+      std::vector<ProbeResult>& results) const;
+
+public:
+
   /** 
    * @return DTHR threshold in internal units.
    */
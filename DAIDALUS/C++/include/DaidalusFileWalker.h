@@ -8,6 +8,7 @@
 
 #include "SequenceReader.h"
 #include "Daidalus.h"
+#include "DaidalusJob.h"
 
 namespace larcfm {
 
@@ -36,6 +37,7 @@ public:
   void goPrev();
   int indexOfTime(double t) const;
   void readState(Daidalus& daa);
+  DaidalusJob readJob();
 
 };
 }
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef DAIDALUSJOB_H_
+#define DAIDALUSJOB_H_
+
+#include "TrafficState.h"
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * State update of one ownship, to be processed by a DaidalusService: the states of the ownship and of
+ * its traffic aircraft at a given time. Jobs of the same ownship are identified by the identifier of
+ * the ownship.
+ */
+class DaidalusJob {
+
+private:
+  TrafficState ownship;
+  std::vector<TrafficState> traffic;
+  double time;
+
+public:
+  DaidalusJob();
+
+  /**
+   * Job of ownship own at time t [s], without traffic.
+   */
+  DaidalusJob(const TrafficState& own, double t);
+
+  /**
+   * Adds a traffic aircraft, whose state is given at the time of the job.
+   */
+  void addTraffic(const TrafficState& ac);
+
+  /**
+   * @return identifier of the ownship.
+   */
+  std::string ownshipId() const;
+
+  const TrafficState& getOwnship() const;
+
+  const std::vector<TrafficState>& getTraffic() const;
+
+  /**
+   * @return time of the states [s].
+   */
+  double getTime() const;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef DAIDALUSRESULT_H_
+#define DAIDALUSRESULT_H_
+
+#include "KinematicBands.h"
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Alerts and kinematic bands of one aircraft of a Daidalus object when this aircraft is
+ * considered the ownship and all the other aircraft are traffic. Aircraft are referred to
+ * by their indices in the aircraft list of the Daidalus object.
+ */
+class DaidalusResult {
+
+private:
+  int index;
+  std::string id;
+  std::vector<int> alerts;
+  KinematicBands bands;
+
+public:
+  DaidalusResult();
+
+  DaidalusResult(int index, const std::string& id, const std::vector<int>& alerts, const KinematicBands& bands);
+
+  /**
+   * Result that takes the bands, including the bands already computed, without copying them.
+   */
+  DaidalusResult(int index, const std::string& id, const std::vector<int>& alerts, KinematicBands&& bands);
+
+  /**
+   * @return index of the ownship in the aircraft list.
+   */
+  int ownshipIndex() const;
+
+  /**
+   * @return identifier of the ownship.
+   */
+  std::string ownshipId() const;
+
+  /**
+   * @return alert type of the ownship and aircraft at index ac. The number 0 means no alert.
+   * A negative number means that aircraft index is not valid or that it is the ownship.
+   */
+  int alerting(int ac) const;
+
+  /**
+   * @return kinematic bands of the ownship. Bands have already been computed.
+   */
+  KinematicBands& getKinematicBands();
+
+};
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef DAIDALUSSERVICE_H_
+#define DAIDALUSSERVICE_H_
+
+#include "Daidalus.h"
+#include "DaidalusJob.h"
+#include "DaidalusResult.h"
+#include "ErrorLog.h"
+#include "ErrorReporter.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Timing of a job processed by a DaidalusService.
+ */
+class DaidalusJobStats {
+
+private:
+  double wait_time;
+  double compute_time;
+  int worker;
+
+public:
+  DaidalusJobStats();
+
+  DaidalusJobStats(double wait_time, double compute_time, int worker);
+
+  /**
+   * @return time [s] from the submission of the job to the start of its computation.
+   */
+  double waitTime() const;
+
+  /**
+   * @return time [s] spent computing alerts and bands, not including the callback.
+   */
+  double computeTime() const;
+
+  /**
+   * @return waitTime()+computeTime().
+   */
+  double latency() const;
+
+  /**
+   * @return index of the worker that processed the job, or -1 if it was processed by the thread that
+   * submitted it.
+   */
+  int workerIndex() const;
+
+};
+
+/**
+ * Scheduler of jobs of many independent ownships. The service keeps one Daidalus object per ownship,
+ * a copy of the Daidalus object given at construction, so that all ownships share its parameters, wind field, and
+ * detector. Jobs are submitted from any thread. A job sets the ownship and traffic states of the Daidalus
+ * object of its ownship, and computes the alerts of each traffic aircraft and the kinematic bands of the
+ * ownship. Results are delivered to the callback, in the worker thread that processed the job.<p>
+ *
+ * Jobs of the same ownship are processed one at a time, in the order they were submitted. Jobs of
+ * different ownships are processed in parallel. Each worker has a queue of ownships with pending jobs.
+ * An ownship is queued by the worker that last processed it, which keeps its Daidalus object in the cache
+ * of that worker. A worker whose queue is empty takes ownships from the back of the queues of the other
+ * workers.<p>
+ *
+ * A service with 0 workers processes each job in the thread that submits it.<p>
+ *
+ * An exception thrown by the callback is caught by the service, which adds an error message and goes on
+ * with the next jobs. The job counts as completed. The errors and warnings of the Daidalus object of an
+ * ownship are added to the messages of the service after each job of the ownship.<p>
+ *
+ * The Daidalus object of an ownship is kept until the ownship is removed (see removeOwnship).
+ */
+class DaidalusService : public ErrorReporter {
+
+public:
+  /**
+   * Callback that receives each job, its result, and its timing. The result has index 0 for the
+   * ownship, and index i, for i >= 1, for the (i-1)-th traffic aircraft of the job. Callbacks of different
+   * ownships may be called concurrently.
+   */
+  typedef std::function<void(const DaidalusJob&, DaidalusResult&, const DaidalusJobStats&)> Callback;
+
+  /**
+   * Construct a service with the given number of worker threads. Daidalus objects of the ownships are
+   * copies of daa.
+   */
+  DaidalusService(const Daidalus& daa, int workers, const Callback& callback);
+
+  /**
+   * Waits for all the submitted jobs to complete and stops the workers.
+   */
+  ~DaidalusService();
+
+  /**
+   * Queues a job. The job is processed after the jobs of the same ownship that have already been submitted.
+   */
+  void submit(const DaidalusJob& job);
+
+  /**
+   * Removes the ownship id and its Daidalus object, once the jobs of the ownship that have already been
+   * submitted are processed. A job of the ownship submitted afterwards is processed by a new copy of the
+   * Daidalus object given at construction. Returns false if the service has no ownship id.
+   */
+  bool removeOwnship(const std::string& id);
+
+  /**
+   * Waits for all the submitted jobs to complete.
+   */
+  void wait();
+
+  /**
+   * @return number of worker threads.
+   */
+  int size() const;
+
+  /**
+   * @return number of ownships that have submitted jobs and have not been removed.
+   */
+  int ownshipCount() const;
+
+  /**
+   * @return number of completed jobs.
+   */
+  long completedJobs() const;
+
+  /**
+   * @return maximum latency [s] of the completed jobs.
+   */
+  double maxLatency() const;
+
+  /**
+   * @return average latency [s] of the completed jobs, or 0 if no job has completed.
+   */
+  double averageLatency() const;
+
+  bool hasError() const;
+
+  bool hasMessage() const;
+
+  std::string getMessage();
+
+  std::string getMessageNoClear() const;
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  class Pending {
+  public:
+    DaidalusJob job;
+    Clock::time_point submitted;
+    bool reset; // The job was submitted after the removal of its ownship
+  };
+
+  class Ownship {
+  public:
+    std::string id;
+    Daidalus* daa;
+    std::deque<Pending> jobs;
+    bool scheduled;
+    bool removed;
+    int home;
+    Ownship(const std::string& id, const Daidalus& daa);
+    ~Ownship();
+  private:
+    Ownship(const Ownship&);
+    Ownship& operator=(const Ownship&);
+  };
+
+  DaidalusService(const DaidalusService&);
+  DaidalusService& operator=(const DaidalusService&);
+
+  void worker(int w);
+  Ownship* take(int w);
+  void process(Ownship* own, const Pending& p, int w);
+  void release(Ownship* own);
+  void completed(double latency);
+  void failed(const DaidalusJob& job, const std::string& what);
+
+  Daidalus prototype;
+  Callback callback;
+  std::map<std::string,Ownship*> ownships;
+  std::vector<std::deque<Ownship*> > queues;
+  std::vector<std::thread> workers;
+  mutable std::mutex mutex;
+  std::condition_variable cv;
+  std::condition_variable idle;
+  int pending;
+  int next_home;
+  bool stop;
+  long jobs_done;
+  double max_latency;
+  double sum_latency;
+  ErrorLog error;
+};
+
+}
+
+#endif
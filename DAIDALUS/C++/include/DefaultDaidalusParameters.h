@@ -9,17 +9,32 @@
 
 #include "DaidalusParameters.h"
 #include <string>
+#include <memory>
+#include <mutex>
 
 namespace larcfm {
 
-/** Horizontal solution */
+/**
+ * Default parameters of new Daidalus and KinematicBands objects. The defaults are kept in an immutable
+ * snapshot that is shared by the readers: getSnapshot only copies a reference, and the snapshot does not
+ * change while it is in use. Setters copy the parameters, when some snapshot is in use, before changing
+ * them. All methods are thread safe.
+ */
 class DefaultDaidalusParameters {
 private:
-  static DaidalusParameters parameters;
+  static std::shared_ptr<const DaidalusParameters> parameters;
+  static std::mutex mutex;
+
+  static DaidalusParameters& writable();
 
 public:
   static DaidalusParameters getParameters();
 
+  /**
+   * @return current default parameters. Later changes of the defaults do not modify the returned parameters.
+   */
+  static std::shared_ptr<const DaidalusParameters> getSnapshot();
+
   /**
    * @return default DTHR threshold in internal units.
    */
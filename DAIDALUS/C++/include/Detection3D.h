@@ -20,7 +20,10 @@
 #include "ConflictData.h"
 #include "string_util.h"
 #include "ParameterAcceptor.h"
+#include "Util.h"
+#include "TrafficArrays.h"
 #include <string>
+#include <cmath>
 
 namespace larcfm {
 
@@ -32,6 +35,20 @@ public:
   virtual bool conflict(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const = 0;
   virtual ConflictData conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const = 0;
 
+  /**
+   * Returns true if the ownship at so, with velocity vo, is in violation with any aircraft in traffic, where
+   * the position of each aircraft is linearly projected t seconds ahead. Detectors may override this method
+   * with a loop over the traffic arrays that the compiler can vectorize.
+   */
+  virtual bool anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const;
+
+  /**
+   * Returns true if the ownship at so, with velocity vo, is in conflict with any aircraft in traffic in
+   * the time interval [B,T], where the position of each aircraft is linearly projected t seconds ahead.
+   * Detectors may override this method with a loop over the traffic arrays that the compiler can vectorize.
+   */
+  virtual bool anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const;
+
   /** This returns a pointer to a new instance of this type of Detector3D.  You are responsible for destroying this instance when it is no longer needed. */
   virtual Detection3D* copy() const = 0;
   virtual Detection3D* make() const = 0;
@@ -50,6 +67,20 @@ public:
   }
   virtual std::string toString() const = 0;
 
+  /**
+   * Integer tag of the class of this detector, see Detection3DRegistry. Two detectors have the same tag if and only if
+   * they have the same canonical class name. The default implementation looks up the canonical class name in the
+   * registry, built-in detectors return a constant. Subclasses that override getSimpleClassName should also
+   * override this method.
+   */
+  virtual int getClassTag() const;
+
+  /**
+   * Integer tag of the super class of this detector, see Detection3DRegistry. Two detectors have the same tag if and
+   * only if they have the same canonical super class name.
+   */
+  virtual int getSuperClassTag() const;
+
   virtual std::string getIdentifier() const = 0;
   virtual void setIdentifier(const std::string& s) = 0;
 
@@ -66,10 +97,51 @@ public:
 
   virtual bool contains(const Detection3D* cd) const = 0;
 
+  /**
+   * Upper bound of the horizontal distance between two aircraft in violation, when their relative
+   * horizontal speed is at most vh. A negative value means that the detector provides no bound.
+   */
+  virtual double horizontalViolationBound(double vh) const {
+    return -1;
+  }
+
+  /**
+   * Upper bound of the vertical distance between two aircraft in violation, when their relative
+   * vertical speed is at most vz. A negative value means that the detector provides no bound.
+   */
+  virtual double verticalViolationBound(double vz) const {
+    return -1;
+  }
+
+  /**
+   * Returns true if two aircraft with relative position s, and relative horizontal and vertical speeds
+   * of at most vh and vz, cannot be in violation at any time in [0,T]. This test is conservative and
+   * does not require a call to violation or conflict detection.
+   */
+  bool unreachable(const Vect3& s, double vh, double vz, double T) const {
+    if (!(T > 0) || ISINF(T)) {
+      return false;
+    }
+    double hb = horizontalViolationBound(vh);
+    double vb = verticalViolationBound(vz);
+    return (hb >= 0 && !Util::almost_leq(s.vect2().norm()-vh*T,hb)) ||
+        (vb >= 0 && !Util::almost_leq(std::abs(s.z)-vz*T,vb));
+  }
+
   bool instanceOf(const std::string& classname) const {
     return larcfm::equals(getCanonicalClassName(), classname);
   }
 
+protected:
+  /**
+   * Sets keep[j] to true if the aircraft i0+j of traffic, for j in [0,n), linearly projected t seconds ahead,
+   * may be in violation with the ownship at so, with velocity vo, at some time in [B,T]. Violations are assumed
+   * to be within a horizontal distance h0+h1*vh and a vertical distance z0+z1*vz, where vh and vz are the
+   * relative horizontal and vertical speeds of the aircraft. Unless 0 <= B < T and T is finite, all aircraft are kept.
+   */
+  static void reachable_block(char* keep, int i0, int n, const Vect3& so, const Velocity& vo, const TrafficArrays& traffic,
+      double t, double B, double T, double h0, double h1, double z0, double z1);
+
 };
 
 inline Detection3D::~Detection3D(){}
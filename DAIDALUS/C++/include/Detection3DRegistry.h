@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef DETECTION3DREGISTRY_H_
+#define DETECTION3DREGISTRY_H_
+
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+class Detection3D;
+
+/**
+ * Registry of detector classes, indexed by canonical class name. Each class name has an integer tag,
+ * so that the class of a detector can be checked without comparing strings (see Detection3D::getClassTag
+ * and Detection3D::getSuperClassTag). Classes with a registered prototype can be instantiated by name.<p>
+ *
+ * The built-in detectors CDCylinder, WCV_TAUMOD, WCV_TCPA, and TCAS3D are always registered. A custom
+ * detector is registered by passing an instance of it to registerDetector. Registration is thread safe.
+ */
+class Detection3DRegistry {
+
+public:
+  /** Tag of classes that are not registered */
+  static const int UNKNOWN = -1;
+  /** Tags of built-in classes */
+  static const int TAG_CDCYLINDER = 0;
+  static const int TAG_WCV_TVAR = 1;
+  static const int TAG_WCV_TAUMOD = 2;
+  static const int TAG_WCV_TCPA = 3;
+  static const int TAG_TCAS3D = 4;
+
+  /**
+   * Registers a copy of det as the prototype of its class, replacing any previous prototype of that
+   * class. The class name and the super class name of det are given tags, if they do not have one yet.
+   * @return the tag of the class of det
+   */
+  static int registerDetector(const Detection3D& det);
+
+  /**
+   * @return the tag of the given class name, or UNKNOWN if the class name is not registered. Both canonical
+   * names, e.g., "gov.nasa.larcfm.ACCoRD.WCV_TAUMOD", and simple names, e.g., "WCV_TAUMOD", are accepted.
+   */
+  static int tag(const std::string& classname);
+
+  /**
+   * @return true if there is a prototype for the given class name
+   */
+  static bool isRegistered(const std::string& classname);
+
+  /**
+   * This returns a pointer to a new copy of the prototype of the given class name, or NULL if there is
+   * no such prototype. You are responsible for destroying this instance when it is no longer needed.
+   */
+  static Detection3D* make(const std::string& classname);
+
+  /**
+   * @return canonical class names of the registered prototypes
+   */
+  static std::vector<std::string> classNames();
+
+};
+
+}
+
+#endif
@@ -15,21 +15,76 @@
 
 #include "ErrorReporter.h"
 #include <string>
+#include <vector>
+#include <atomic>
 
 namespace larcfm {
 
+/**
+ * Log of errors and warnings. Messages are kept in a ring buffer that holds the last messages, up to the size
+ * limit (see setSizeLimit). Each message has a code and, for messages added with a code, a text that is formatted
+ * only when the log is read: the text may contain placeholders '%' that are replaced by numeric arguments. The
+ * text of these messages must be a string literal, or a string that outlives the log.<p>
+ *
+ * A log is not shared between objects, and it may be used concurrently with other logs.
+ */
 class ErrorLog : public ErrorReporter {
+public:
+  /** Codes of messages */
+  enum Code {
+    /** Message added as a string */
+    UNSPECIFIED,
+    /** Index of an aircraft or a band out of bounds */
+    INVALID_INDEX,
+    /** Time out of the time horizon */
+    INVALID_TIME,
+    /** Parameter value out of range */
+    INVALID_VALUE,
+    /** No ownship or traffic information */
+    NO_DATA,
+    /** Aircraft, detector, or file not found */
+    NOT_FOUND,
+    /** Inconsistent use of geodesic and Euclidean data */
+    INCONSISTENT_DATA,
+    /** Operation not supported by the detector */
+    WRONG_DETECTOR
+  };
+
 private:
+  class Entry {
+  public:
+    bool error;
+    Code code;
+    const char* where;
+    const char* text;
+    std::string str;   // Message, or argument of the placeholder of text when sarg is true
+    bool sarg;
+    double args[2];
+    int nargs;
+    int precision;
+  };
+
   std::string name;
-  std::string message;
+  std::vector<Entry> entries;
+  int first;      // Index of the oldest message in the ring
+  int count;      // Number of messages
+  int capacity;   // Size of the ring, i.e., the limit when the last message was added
+  bool dropped;
   bool has_error;
   bool fail_fast;
   bool console_out;
   int local_purge_flag;
-  static int global_purge_flag;
-  static int limit;
-  int size;
-	
+  static std::atomic<int> global_purge_flag;
+  static std::atomic<int> limit;
+
+  /** Returns the entry of a new message, dropping the oldest message when the log is full */
+  Entry& next(bool error, Code code);
+  /** Message i, from the oldest, which must be in [0,count) */
+  const Entry& entry(int i) const;
+  void added(const Entry& e);
+  std::string format(const Entry& e) const;
+  void add(bool error, Code code, const char* where, const char* text, int precision, int nargs, double a, double b);
+
 public:
   /**
    * Construct a new ErrorLog object.  Every message includes the name of this error log.
@@ -61,6 +116,66 @@ public:
    */
   void addWarning(const std::string& msg);
 
+  /**
+   * Indicate that an error with the given code has occurred. The text is formatted when the log is read.
+   * @param code the code of the error
+   * @param text the error message, a string literal
+   */
+  void addError(Code code, const char* text);
+
+  /**
+   * Indicate that an error with the given code has occurred. The placeholder '%' in the text is replaced
+   * by the value a, without decimals, when the log is read.
+   */
+  void addError(Code code, const char* text, double a);
+
+  /**
+   * Indicate that an error with the given code has occurred. The placeholders '%' in the text are replaced
+   * by the values a and b, in this order and without decimals, when the log is read.
+   */
+  void addError(Code code, const char* text, double a, double b);
+
+  /**
+   * Indicate that an error with the given code has occurred.
+   * @param code the code of the error
+   * @param msg the error message
+   */
+  void addError(Code code, const std::string& msg);
+
+  /**
+   * Indicate that a warning with the given code has occurred.
+   * @param code the code of the warning
+   * @param msg the warning message
+   */
+  void addWarning(Code code, const std::string& msg);
+
+  /**
+   * Indicate that a warning with the given code has occurred. The text is formatted when the log is read.
+   * @param code the code of the warning
+   * @param text the warning message, a string literal
+   */
+  void addWarning(Code code, const char* text);
+
+  /**
+   * Indicate that a warning with the given code has occurred. The placeholder '%' in the text is replaced
+   * by the value a, without decimals, when the log is read.
+   */
+  void addWarning(Code code, const char* text, double a);
+
+  /**
+   * Indicate that an error with the given code has occurred in method where. The placeholder '%' in the text
+   * is replaced by the string arg when the log is read. The method and the text must be string literals, the
+   * argument is copied.
+   */
+  void addError(Code code, const char* where, const char* text, const std::string& arg);
+
+  /**
+   * Indicate that a warning with the given code has occurred in method where. The placeholder '%' in the text
+   * is replaced by the string arg when the log is read. The method and the text must be string literals, the
+   * argument is copied.
+   */
+  void addWarning(Code code, const char* where, const char* text, const std::string& arg);
+
 	/**
 	 * Add all the errors and warnings from the given ErrorReporter into the
 	 * current ErrorLog.  The given ErrorReporter's status (as indicated
@@ -85,13 +200,27 @@ public:
 
   /**
    * Checks if a value is positive and, in that case, returns true. Otherwise,
-   * adds an error message and returns false.
+   * adds an error message and returns false. The message is formatted when the log is read,
+   * so method must be a string literal.
    */
-  bool isPositive(const std::string& method, double val);
+  bool isPositive(const char* method, double val);
+
+  /**
+   * Checks if a value is non negative and, in that case, returns true. Otherwise,
+   * adds an error message and returns false. The message is formatted when the log is read,
+   * so method must be a string literal.
+   */
+  bool isNonNegative(const char* method, double val);
 
   /**
    * Checks if a value is positive and, in that case, returns true. Otherwise,
-   * adds an error message and returns false.
+   * adds an error message and returns false. The name of the method is copied.
+   */
+  bool isPositive(const std::string& method, double val);
+
+  /**
+   * Checks if a value is non negative and, in that case, returns true. Otherwise,
+   * adds an error message and returns false. The name of the method is copied.
    */
   bool isNonNegative(const std::string& method, double val);
 
@@ -99,6 +228,21 @@ public:
   bool hasMessage() const;
   std::string getMessage();
   std::string getMessageNoClear() const;
+
+  /** Number of messages in the log */
+  int messageCount() const;
+
+  /** True if message i, from the oldest, is an error. False if i is not in [0,messageCount()) */
+  bool isError(int i) const;
+
+  /** Code of message i, from the oldest. UNSPECIFIED if i is not in [0,messageCount()) */
+  Code getCode(int i) const;
+
+  /**
+   * Text of message i, from the oldest, without the name of the log. Empty if i is not
+   * in [0,messageCount())
+   */
+  std::string getText(int i) const;
 };
 
 }
@@ -47,13 +47,15 @@ namespace larcfm {
  * }
  * </pre>
  *
- * The current implementation does not allocate any dynamic (heap) memory.
+ * The current implementation keeps up to inline_intervals intervals in a buffer
+ * that is part of the object. Larger sets spill to the heap. IntervalSets can be
+ * moved, in which case a heap buffer is transferred without copying.
  */
 class IntervalSet {// : ErrorReporter {
 
 public:
-	/** The maximum number of intervals */
-	static const int max_intervals = 400;
+	/** The number of intervals that are stored without allocating heap memory */
+	static const int inline_intervals = 16;
 
 public:
 	/** Construct an empty IntervalSet */
@@ -61,6 +63,19 @@ public:
 	/** Copy the IntervalSet into a new set */ 
 	IntervalSet(const IntervalSet& l);
 
+	/** Move the IntervalSet into a new set, l is left empty */
+	IntervalSet(IntervalSet&& l);
+
+	~IntervalSet();
+
+	IntervalSet& operator=(const IntervalSet& l);
+
+	/** Move the IntervalSet into this set, l is left empty */
+	IntervalSet& operator=(IntervalSet&& l);
+
+	/** Exchange the contents of this set and l */
+	void swap(IntervalSet& l);
+
 	/** Build an IntervalSet from the given vector */
 	IntervalSet(const std::vector<Interval>& v);
 
@@ -177,10 +192,15 @@ private:
 	void insert(int i, const Interval& r);
 	void remove(int i);
 	void remove(int i, int len);
+	void append(const Interval& rn);
+	void reserve(int n);
+	void take(IntervalSet& l);
 
 	static const Interval empty;
-	Interval r[max_intervals];
+	Interval* r;     // Either buf or a heap buffer of size capacity
 	int length;
+	int capacity;
+	Interval buf[inline_intervals];
 	//    mutable ErrorLog error;
 };
 
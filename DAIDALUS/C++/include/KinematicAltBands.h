@@ -8,6 +8,7 @@
 #define KINEMATICALTBANDS_H_
 
 #include "KinematicRealBands.h"
+#include "DaidalusParameters.h"
 #include "Detection3D.h"
 #include "TrafficState.h"
 #include "OwnshipState.h"
@@ -29,8 +30,15 @@ double vertical_accel; // Climb/descend acceleration
 public:
 KinematicAltBands();
 
+/** Bands with the parameters of the given object */
+explicit KinematicAltBands(const DaidalusParameters& parameters);
+
 KinematicAltBands(const KinematicAltBands& b);
 
+KinematicAltBands(KinematicAltBands&& b) = default;
+KinematicAltBands& operator=(const KinematicAltBands& b) = default;
+KinematicAltBands& operator=(KinematicAltBands&& b) = default;
+
 void setVerticalRate(double val);
 
 void setVerticalAcceleration(double val);
@@ -50,6 +58,11 @@ bool all_red(Detection3D* conflict_det, Detection3D* recovery_det, const Traffic
 void none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac, double B, double T,
     const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
 
+/**
+ * Altitude bands are not computed from the none bands of each aircraft. Therefore, all bands are reset.
+ */
+void resetTraffic(const std::string& id);
+
 private:
 /**
  * Returns true if aircraft are currently in Violation
@@ -23,6 +23,7 @@
 #include "KinematicAltBands.h"
 #include "ErrorLog.h"
 #include "UrgencyStrategy.h"
+#include "ThreadPool.h"
 #include <vector>
 #include <string>
 
@@ -58,11 +59,27 @@ public:
    */
   KinematicBands();
 
+  /**
+   * Construct a KinematicBands object with the given detector and parameters. This is the same as
+   * constructing it with the detector and calling setParameters, without reading the default parameters.
+   */
+  KinematicBands(const Detection3D* detector, const DaidalusParameters& parameters);
+
   /**
    * Construct a KinematicBands object from an existing KinematicBands object. This copies all traffic data.
    */
   KinematicBands(const KinematicBands& b);
 
+  /**
+   * Construct a KinematicBands object that takes the detector, the traffic, and the computed bands of b,
+   * without copying them. Afterwards, b may only be destroyed or assigned.
+   */
+  KinematicBands(KinematicBands&& b) = default;
+
+  KinematicBands& operator=(const KinematicBands& b) = default;
+
+  KinematicBands& operator=(KinematicBands&& b) = default;
+
   /** Ownship and Traffic **/
 
   OwnshipState getOwnship() const;
@@ -91,6 +108,18 @@ public:
 
   void addTraffic(const Position& pi, const Velocity& vi);
 
+  /**
+   * Replaces the state of the aircraft with the same identifier as ac, or adds ac if there is no such
+   * aircraft. Only the bands of this aircraft are recomputed, unless it is the criteria aircraft.
+   */
+  void updateTraffic(const TrafficState& ac);
+
+  /**
+   * Removes all aircraft with identifier id. Only the bands of this aircraft are recomputed,
+   * unless it is the criteria aircraft.
+   */
+  void removeTraffic(const std::string& id);
+
   /** General Settings **/
 
   void setParameters(const DaidalusParameters& parameters);
@@ -353,7 +382,8 @@ public:
   double getBankAngle(const std::string& u) const;
 
   /**
-   * Sets bank angle for track bands to value in internal units.
+   * Sets bank angle for track bands to value in internal units. When both bank angle
+   * and turn rate are 0, track bands are computed for instantaneous maneuvers.
    */
   void setBankAngle(double val);
 
@@ -373,7 +403,8 @@ public:
   double getTurnRate(const std::string& u) const;
 
   /**
-   * Sets turn rate for track bands to value in internal units.
+   * Sets turn rate for track bands to value in internal units. When both bank angle
+   * and turn rate are 0, track bands are computed for instantaneous maneuvers.
    */
   void setTurnRate(double val);
 
@@ -465,6 +496,7 @@ public:
 
   /**
    * Sets horizontal acceleration for ground speed bands to value in internal units.
+   * When horizontal acceleration is 0, ground speed bands are computed for instantaneous maneuvers.
    */
   void setHorizontalAcceleration(double val);
 
@@ -559,7 +591,8 @@ public:
 
   /**
    * Sets the constant vertical acceleration for vertical speed and altitude bands
-   * to value in internal units.
+   * to value in internal units. When vertical acceleration is 0, vertical speed bands
+   * are computed for instantaneous maneuvers.
    */
   void setVerticalAcceleration(double val);
 
@@ -671,15 +704,55 @@ public:
 protected:
   void reset();
 
+  /* Reset the bands of aircraft id */
+  void resetTraffic(const std::string& id);
+
 public:
 
   /** Main interface methods **/
 
+  /**
+   * Sets the thread pool used by computeAllBands. When pool is NULL, bands are computed
+   * sequentially. The pool is not owned by this object and must outlive its use.
+   */
+  void setThreadPool(ThreadPool* pool);
+
+  /**
+   * @return the thread pool used by computeAllBands, or NULL if none has been set.
+   */
+  ThreadPool* getThreadPool() const;
+
+  /**
+   * Compute track, ground speed, vertical speed, and altitude bands now. Usually, bands are
+   * only computed when needed. If a thread pool has been set, the bands of each dimension, and
+   * the left and right sweeps within a dimension, are computed as parallel tasks. The result is
+   * the same as the one computed on demand.
+   */
+  void computeAllBands();
+
+  /**
+   * @return the number of times, added over track, ground speed, and vertical speed bands, that an aircraft
+   * has been found not alerting without calling the detector, because it cannot be in conflict with the
+   * ownship within alerting time.
+   */
+  int prunedTrafficCount() const;
+
   /**
    * @return the number of track band intervals, negative if the ownship has not been set
    */
   int trackLength();
 
+  /**
+   * @return track band intervals in internal units [rad], computed if needed. The reference is valid until the
+   * bands are modified or this object is destroyed. There are no intervals if the ownship has not been set.
+   */
+  const std::vector<Interval>& trackIntervals();
+
+  /**
+   * @return regions of the track band intervals, see trackIntervals().
+   */
+  const std::vector<BandsRegion::Region>& trackRegions();
+
   /**
    * Force computation of track bands. Usually, bands are only computed when needed. This method
    * forces the computation of track bands (this method is included mainly for debugging purposes).
@@ -731,6 +804,17 @@ public:
    */
   int groundSpeedLength();
 
+  /**
+   * @return ground speed band intervals in internal units [m/s], computed if needed. The reference is valid until the
+   * bands are modified or this object is destroyed. There are no intervals if the ownship has not been set.
+   */
+  const std::vector<Interval>& groundSpeedIntervals();
+
+  /**
+   * @return regions of the ground speed band intervals, see groundSpeedIntervals().
+   */
+  const std::vector<BandsRegion::Region>& groundSpeedRegions();
+
   /**
    * Force computation of ground speed bands. Usually, bands are only computed when needed. This method
    * forces the computation of ground speed bands (this method is included mainly for debugging purposes).
@@ -781,6 +865,17 @@ public:
    */
   int verticalSpeedLength();
 
+  /**
+   * @return vertical speed band intervals in internal units [m/s], computed if needed. The reference is valid until the
+   * bands are modified or this object is destroyed. There are no intervals if the ownship has not been set.
+   */
+  const std::vector<Interval>& verticalSpeedIntervals();
+
+  /**
+   * @return regions of the vertical speed band intervals, see verticalSpeedIntervals().
+   */
+  const std::vector<BandsRegion::Region>& verticalSpeedRegions();
+
   /**
    * Force computation of vertical speed bands. Usually, bands are only computed when needed. This method
    * forces the computation of vertical speed bands (this method is included mainly for debugging purposes).
@@ -833,6 +928,17 @@ public:
    */
   int altitudeLength();
 
+  /**
+   * @return altitude band intervals in internal units [m], computed if needed. The reference is valid until the
+   * bands are modified or this object is destroyed. There are no intervals if the ownship has not been set.
+   */
+  const std::vector<Interval>& altitudeIntervals();
+
+  /**
+   * @return regions of the altitude band intervals, see altitudeIntervals().
+   */
+  const std::vector<BandsRegion::Region>& altitudeRegions();
+
   /**
    * Force computation of altitude bands. Usually, bands are only computed when needed. This method
    * forces the computation of altitude bands (this method is included mainly for debugging purposes).
@@ -15,6 +15,7 @@
 #include "TrafficState.h"
 #include "OwnshipState.h"
 #include "TCASTable.h"
+#include "DaidalusParameters.h"
 #include <vector>
 #include <string>
 
@@ -24,7 +25,7 @@ class KinematicBandsCore : public Detection3DAcceptor {
 
 public:
 
-  static TCASTable RA;
+  static const TCASTable RA;
 
   /* Absolute ownship state */
   OwnshipState ownship;
@@ -63,13 +64,21 @@ public:
 
   KinematicBandsCore(const Detection3D* det);
 
+  /** Core with a copy of the detector det and the parameters of the given object */
+  KinematicBandsCore(const Detection3D* det, const DaidalusParameters& parameters);
+
   KinematicBandsCore(const KinematicBandsCore& core);
 
+  /** Takes the detector and the traffic of core, which may only be destroyed or assigned afterwards */
+  KinematicBandsCore(KinematicBandsCore&& core);
+
   ~KinematicBandsCore();
 
   // needed because of pointer
   KinematicBandsCore& operator=(const KinematicBandsCore& core);
 
+  KinematicBandsCore& operator=(KinematicBandsCore&& core);
+
 
   /**
    *  Clear ownship and traffic data from this object.   
@@ -151,6 +160,9 @@ public:
   void setCoreDetectionPtr(const Detection3D* cd);
   void setCoreDetectionRef(const Detection3D& cd);
 
+private:
+  void init(const DaidalusParameters& parameters);
+
 };
 
 }
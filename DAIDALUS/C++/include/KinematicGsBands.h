@@ -8,6 +8,7 @@
 #define KINEMATICGSBANDS_H_
 
 #include "KinematicRealBands.h"
+#include "DaidalusParameters.h"
 #include "Detection3D.h"
 #include "TrafficState.h"
 #include "OwnshipState.h"
@@ -26,8 +27,15 @@ class KinematicGsBands : public KinematicRealBands {
   public:
   KinematicGsBands();
 
+  /** Bands with the parameters of the given object */
+  explicit KinematicGsBands(const DaidalusParameters& parameters);
+
   KinematicGsBands(const KinematicGsBands& b);
 
+  KinematicGsBands(KinematicGsBands&& b) = default;
+  KinematicGsBands& operator=(const KinematicGsBands& b) = default;
+  KinematicGsBands& operator=(KinematicGsBands&& b) = default;
+
   void setHorizontalAcceleration(double val);
 
   double getHorizontalAcceleration() const;
@@ -42,6 +50,21 @@ class KinematicGsBands : public KinematicRealBands {
 
   void none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac, double B, double T,
       const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+
+  bool exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+      double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const;
+
+  protected:
+  double max_ownship_gs(const OwnshipState& ownship) const;
+
+  bool instantaneous_bands() const;
+
+  double instantaneous_value(const Velocity& v) const;
+
+  Velocity instantaneous_velocity(const Velocity& v, double val) const;
+
+  void critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+      double D, double H, double B, double T) const;
   };
 
 }
@@ -14,6 +14,8 @@
 #include "OwnshipState.h"
 #include "Integerval.h"
 #include "IntervalSet.h"
+#include "ThreadPool.h"
+#include "TrafficArrays.h"
 #include <vector>
 #include <string>
 
@@ -23,36 +25,108 @@ namespace larcfm {
 class KinematicIntegerBands {
 
   public:
+  KinematicIntegerBands();
+
+  KinematicIntegerBands(const KinematicIntegerBands& b) = default;
+  KinematicIntegerBands(KinematicIntegerBands&& b) = default;
+  KinematicIntegerBands& operator=(const KinematicIntegerBands& b) = default;
+  KinematicIntegerBands& operator=(KinematicIntegerBands&& b) = default;
+
   virtual std::pair<Vect3,Velocity> trajectory(const OwnshipState& ownship, double time, bool dir) const = 0;
   virtual ~KinematicIntegerBands() {}
 
+  /**
+   * Loss of separation status of the ownship at each step of a maneuver, for a conflict detector
+   * and a recovery detector. These results do not depend on the time interval of a query. Therefore,
+   * they can be shared by queries that only differ in their time intervals, e.g., the probes of a
+   * bisection on time. A cache must only be used with the same ownship, traffic, detectors, and
+   * bands parameters.
+   */
+  class LosCache {
+  public:
+    void clear();
   private:
+    friend class KinematicIntegerBands;
+    // Indexed by detector (0: conflict, 1: recovery), direction (0: left, 1: right), and step.
+    // Values are 0: unknown, 1: loss of separation, 2: no loss of separation.
+    std::vector<char> los[2][2];
+  };
+
+  /**
+   * Sets the thread pool used to run the left and right sweeps of kinematic_bands_combine
+   * in parallel. When pool is NULL, the sweeps run sequentially in the calling thread.
+   * The pool is not owned by this object.
+   */
+  void setThreadPool(ThreadPool* pool);
+
+  ThreadPool* getThreadPool() const;
+
+  /**
+   * Clears the ownship trajectory cache. This method should be called when a parameter of
+   * the trajectory changes.
+   */
+  void clear_trajectory_cache() const;
+
+  private:
+  ThreadPool* thread_pool;
+
+  /* Ownship trajectory cache, indexed by direction (0: left, 1: right) and step. It is only
+   * valid for the ownship state and time step in traj_pos, traj_vel, and traj_tstep. */
+  mutable std::vector<std::pair<Vect3,Velocity> > traj_cache[2];
+  mutable std::vector<bool> traj_known[2];
+  mutable Position traj_pos[2];
+  mutable Velocity traj_vel[2];
+  mutable double traj_tstep[2];
+
+  /* Scratch storage reused by the interface functions, so that, once its capacity is large enough,
+   * computing bands does not allocate memory. It is only used by one interface call at a time. */
+  mutable TrafficArrays traffic_arrays;
+  mutable std::vector<Integerval> right_bands;
+
+  void clear_trajectory_cache(bool trajdir) const;
+
+  /* Clears the trajectory cache in direction trajdir, unless it was computed for the same ownship and time step */
+  void prepare_trajectory_cache(const OwnshipState& ownship, double tstep, bool trajdir) const;
+
+  /**
+   * Returns the state of the ownship at time k*tstep along the maneuver in direction trajdir.
+   * States are computed once per sweep and shared by all traffic aircraft and detectors.
+   */
+  std::pair<Vect3,Velocity> trajectory_step(const OwnshipState& ownship, double tstep, bool trajdir, int k) const;
+
   int first_los_step(Detection3D* det, double tstep,bool trajdir,
-      int min, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+      int min, int max, const OwnshipState& ownship, const TrafficArrays& traffic) const;
 
   int first_los_search_index(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
       double B, double T, double B2, double T2, bool trajdir, int max,
-      const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+      const OwnshipState& ownship, const TrafficArrays& traffic) const;
 
   int bands_search_index(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
       double B, double T, double B2, double T2, 
-      bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
+      bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
       int epsh, int epsv) const;
 
   public:
   bool any_conflict(Detection3D* conflict_det, Detection3D* recovery_det, double B, double T, double B2, double T2,
-      bool trajdir, double tsk, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+      bool trajdir, double tstep, int k, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
 
   private:
+  bool any_conflict(Detection3D* conflict_det, Detection3D* recovery_det, double B, double T, double B2, double T2,
+      bool trajdir, double tstep, int k, const OwnshipState& ownship, const TrafficArrays& traffic) const;
+
   void traj_conflict_only_bands(std::vector<Integerval>& l,
       Detection3D* conflict_det, Detection3D* recovery_det, double tstep, double B, double T, double B2, double T2,
-      bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+      bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic) const;
 
   void kinematic_bands(std::vector<Integerval>& l, Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
       double B, double T, double B2, double T2, 
-      bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
+      bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
       int epsh, int epsv) const;
 
+  protected:
+  /* Scratch integer bands for the none_bands function of subclasses */
+  mutable std::vector<Integerval> int_bands;
+
   public:
   static void append_intband(std::vector<Integerval>& l, std::vector<Integerval>& r);
 
@@ -77,14 +151,21 @@ class KinematicIntegerBands {
       int epsh, int epsv) const;
 
   private:
-  bool any_los_aircraft(Detection3D* det, bool trajdir, double tsk,
-      const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+  bool any_los_aircraft(Detection3D* det, bool trajdir, double tstep, int k,
+      const OwnshipState& ownship, const TrafficArrays& traffic) const;
 
-  // trajdir: false is left
+  bool los_at(Detection3D* det, int slot, LosCache* cache, bool trajdir, double tstep, int k,
+      const OwnshipState& ownship, const TrafficArrays& traffic) const;
+
+  /*
+   * Returns the first green step in direction trajdir (false is left) that belongs to a band that, after
+   * scaling by scal and adding add, intersects [minval,maxval]. Returns -1 if there is no such step.
+   * The search stops at the first step with loss of separation or that is not repulsive.
+   */
   int first_green(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
       double B, double T, double B2, double T2,
-      bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
-      int epsh, int epsv) const;
+      bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
+      int epsh, int epsv, double scal, double add, double minval, double maxval, LosCache* cache) const;
 
   // INTERFACE FUNCTION
   public:
@@ -93,6 +174,17 @@ class KinematicIntegerBands {
       int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
       int epsh, int epsv, int dir) const;
 
+  /**
+   * Returns true if the bands computed by kinematic_bands_combine and converted by toIntervalSet (or
+   * toIntervalSet_0_2PI, when minval and maxval are infinite) are not empty. The search stops at the
+   * first green step found. When cache is not NULL, loss of separation results are read from and
+   * stored in the cache.
+   */
+  bool any_int_green(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
+      double B, double T, double B2, double T2,
+      int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
+      int epsh, int epsv, double scal, double add, double minval, double maxval, LosCache* cache) const;
+
   private:
   Vect3 linvel(const OwnshipState& ownship, double tstep, bool trajdir, int k) const;
 
@@ -104,14 +196,11 @@ class KinematicIntegerBands {
 
   int first_nonvert_repul_step(double tstep, bool trajdir, int max, const OwnshipState& ownship, const TrafficState& repac, int epsv) const;
 
-  bool cd_future_traj(Detection3D* det, double B, double T, bool trajdir, double t,
-      const OwnshipState& ownship, const TrafficState& ac) const;
-
-  bool any_conflict_aircraft(Detection3D* det, double B, double T, bool trajdir, double tsk,
-      const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+  bool any_conflict_aircraft(Detection3D* det, double B, double T, bool trajdir, double tstep, int k,
+      const OwnshipState& ownship, const TrafficArrays& traffic) const;
 
   bool any_conflict_step(Detection3D* det, double tstep, double B, double T, bool trajdir, int max,
-      const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+      const OwnshipState& ownship, const TrafficArrays& traffic) const;
 
   // trajdir: false is left
   public:
@@ -120,7 +209,14 @@ class KinematicIntegerBands {
       bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
       int epsh, int epsv) const;
 
+  private:
+  bool red_band_exist(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
+      double B, double T, double B2, double T2,
+      bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
+      int epsh, int epsv) const;
+
   // INTERFACE FUNCTION
+  public:
   bool any_int_red(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
       double B, double T, double B2, double T2,
       int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
@@ -19,6 +19,7 @@
 #include "KinematicIntegerBands.h"
 #include <vector>
 #include <string>
+#include <map>
 
 namespace larcfm {
 
@@ -27,6 +28,29 @@ class KinematicRealBands : public KinematicIntegerBands {
   /* Internal parameters */
 private:
   bool outdated; // Need to compute bands
+  std::vector<std::string> outdated_traffic; // Aircraft whose none bands need to be recomputed
+  // None bands of an aircraft. Entries of aircraft that stop alerting are kept, so that their storage is reused.
+  class TrafficNoneBands {
+  public:
+    bool alerting;
+    IntervalSet none;
+  };
+  // None bands of each aircraft, indexed by identifier. Bands are the intersection of the sets of alerting aircraft.
+  std::map<std::string,TrafficNoneBands> traffic_none_bands;
+  mutable int pruned_traffic; // Number of aircraft dropped by the reachability filter
+
+  /* Scratch traffic lists, reused so that recomputing bands does not allocate memory once their capacity is large enough
+   * (checked by test/ScratchAllocations.cpp) */
+  mutable std::vector<TrafficState> single_traffic; // Aircraft checked by kinematicConflict
+  std::vector<TrafficState> id_traffic;              // Aircraft with a given identifier
+  std::vector<TrafficState> preventive_traffic;      // Preventive alerting aircraft
+  std::vector<TrafficState> corrective_traffic;      // Corrective alerting aircraft
+  std::vector<TrafficState> alerting_traffic;        // All alerting aircraft
+  mutable std::vector<double> critical_vals;         // Critical values of instantaneous bands
+  mutable std::vector<double> critical_splits;       // Sorted critical values of instantaneous bands
+  LosCache recovery_los;                             // Loss of separation results shared by recovery probes
+  std::vector<double> recovery_D;                    // Diameters of the recovery cylinders
+  std::vector<double> recovery_H;                    // Heights of the recovery cylinders
 
   /* Output parameters */
 protected:
@@ -51,6 +75,11 @@ public:
 
   KinematicRealBands(const KinematicRealBands&  b);
 
+  /** Moves the parameters and the computed bands of b, which may only be destroyed or assigned afterwards */
+  KinematicRealBands(KinematicRealBands&& b) = default;
+  KinematicRealBands& operator=(const KinematicRealBands& b) = default;
+  KinematicRealBands& operator=(KinematicRealBands&& b) = default;
+
   virtual ~KinematicRealBands() { }
 
   double getMin() const;
@@ -73,14 +102,36 @@ public:
 
   std::pair<std::vector<TrafficState>,std::vector<TrafficState> > alertingAircraft(const KinematicBandsCore& core) const;
 
+  std::pair<std::vector<TrafficState>,std::vector<TrafficState> > alertingAircraft(const KinematicBandsCore& core,
+      const std::vector<TrafficState>& traffic) const;
+
+  /**
+   * Sets preventive and corrective to the aircraft in traffic that are preventive and corrective alerting,
+   * respectively. Same as alertingAircraft(core,traffic), but reuses the storage of both vectors.
+   */
+  void alertingAircraft(const KinematicBandsCore& core, const std::vector<TrafficState>& traffic,
+      std::vector<TrafficState>& preventive, std::vector<TrafficState>& corrective) const;
+
   std::pair<std::vector<std::string>,std::vector<std::string> > alertingAircraftNames(const KinematicBandsCore& core) const;
 
+  /**
+   * @return number of aircraft that have been found not alerting without calling the detector, because
+   * they cannot be in conflict with the ownship within alerting time for any maneuver in this dimension.
+   */
+  int prunedTrafficCount() const;
+
   double recoveryTime(KinematicBandsCore& core);
 
   int bandsLength(KinematicBandsCore& core);
 
   Interval interval( KinematicBandsCore& core, int i);
 
+  /** Intervals of the bands, computed if needed. There are no intervals if there is no ownship. */
+  const std::vector<Interval>& getIntervals(KinematicBandsCore& core);
+
+  /** Regions of the intervals of the bands, computed if needed */
+  const std::vector<BandsRegion::Region>& getRegions(KinematicBandsCore& core);
+
   BandsRegion::Region region(KinematicBandsCore& core, int i);
 
   BandsRegion::Region regionOf(KinematicBandsCore& core, double val);
@@ -90,9 +141,16 @@ public:
   /* Reset bands */
   void reset();
 
+  /**
+   * Reset the contribution of aircraft id to the bands. When the bands are recomputed, only the none bands
+   * of this aircraft are computed again and intersected with the none bands of the other aircraft.
+   * This method assumes that id is not the criteria aircraft.
+   */
+  virtual void resetTraffic(const std::string& id);
+
   void force_compute(KinematicBandsCore& core);
 
-private:
+  /* Compute bands, if they are outdated */
   void recompute(KinematicBandsCore& core);
 
   // ensure that the intervals are "complete", filling in missing intervals and ensuring the bands end at the proper bounds
@@ -102,6 +160,7 @@ protected:
   // compute recovery bands
 private:
   void compute_recovery_bands(IntervalSet& noneset, KinematicBandsCore& core, const std::vector<TrafficState>& alerting_set);
+  static double clear_scale(double D, double H, double T, const OwnshipState& ownship, const std::vector<TrafficState>& alerting_set);
 
   // compute all bands
 protected:
@@ -117,6 +176,15 @@ public:
   virtual bool all_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
       double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const = 0;
 
+  /**
+   * Returns true if none_bands(noneset,conflict_det,recovery_det,repac,B,T,ownship,traffic) would return a
+   * non-empty set. Subclasses override this method to stop at the first green value, rather than computing
+   * all the bands. When cache is not NULL, loss of separation results are shared with other calls that use
+   * the same cache. A cache is only valid for fixed detectors, ownship, and traffic.
+   */
+  virtual bool exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+      double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const;
+
   bool solid_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
 		 double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic);
 
@@ -128,7 +196,82 @@ public:
 
 private:
   void compute_none_bands(IntervalSet& noneset, const KinematicBandsCore& core, const TrafficState& repac,
-      const std::pair<std::vector<TrafficState>,std::vector<TrafficState> >& alerting_aircraft);
+      const std::vector<TrafficState>& preventive, const std::vector<TrafficState>& corrective);
+
+  /* Compute the none bands of the aircraft with identifier id, or remove them if id is not alerting */
+  void compute_traffic_none_bands(const KinematicBandsCore& core, const std::string& id);
+
+  /* Compute bands from the none bands of each aircraft */
+  void combine_traffic_none_bands(KinematicBandsCore& core);
+
+protected:
+  /**
+   * Upper bound of the horizontal speed of the ownship during any maneuver in this dimension.
+   */
+  virtual double max_ownship_gs(const OwnshipState& ownship) const;
+
+  /**
+   * Upper bound of the absolute vertical speed of the ownship during any maneuver in this dimension.
+   */
+  virtual double max_ownship_vs(const OwnshipState& ownship) const;
+
+  /* Instantaneous bands */
+  /**
+   * Returns true when bands in this dimension are computed assuming instantaneous maneuvers,
+   * i.e., when the kinematic parameter of the dimension (turn rate, acceleration) is zero.
+   */
+  virtual bool instantaneous_bands() const;
+
+  /**
+   * Value of this dimension for velocity v, e.g., track, ground speed, or vertical speed.
+   */
+  virtual double instantaneous_value(const Velocity& v) const;
+
+  /**
+   * Velocity v where the value of this dimension has been instantaneously changed to val.
+   */
+  virtual Velocity instantaneous_velocity(const Velocity& v, double val) const;
+
+  /**
+   * Adds to vals the values of this dimension where an ownship with relative position s,
+   * velocity vo, and an intruder with velocity vi, enter or exit a cylindrical conflict with
+   * dimensions D and H in the time interval [B,T].
+   */
+  virtual void critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+      double D, double H, double B, double T) const;
+
+  /**
+   * Computes none bands of an instantaneous maneuver. When conflict_det and recovery_det are cylinders
+   * and no repulsive criteria apply, bands are computed in closed form from the critical values of
+   * each aircraft in traffic. Otherwise, returns false and leaves noneset unchanged.
+   */
+  bool instantaneous_none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+      double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+
+  /**
+   * Computes integer none bands of an instantaneous maneuver, checking the values vo+j*scal, where
+   * vo is the current value and j ranges from -maxl to maxr.
+   */
+  void instantaneous_bands_combine(std::vector<Integerval>& l, Detection3D* conflict_det, Detection3D* recovery_det,
+      double B, double T, double scal, int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic,
+      const TrafficState& repac, int epsh, int epsv) const;
+
+  /**
+   * Returns true if the none bands of an instantaneous maneuver do not cover the range [min,max].
+   */
+  bool instantaneous_any_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+      double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+
+  /**
+   * Returns true if the none bands of an instantaneous maneuver are empty.
+   */
+  bool instantaneous_all_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+      double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+
+private:
+  bool instantaneous_green(Detection3D* conflict_det, Detection3D* recovery_det, double B, double T,
+      const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const Velocity& nvo,
+      const TrafficState& repac, int epsh, int epsv) const;
 
 public:
   std::string toString() const;
@@ -8,6 +8,7 @@
 #define KINEMATICTRKBANDS_H_
 
 #include "KinematicRealBands.h"
+#include "DaidalusParameters.h"
 #include "Detection3D.h"
 #include "TrafficState.h"
 #include "OwnshipState.h"
@@ -27,8 +28,15 @@ class KinematicTrkBands : public KinematicRealBands {
   public:
   KinematicTrkBands();
 
+  /** Bands with the parameters of the given object */
+  explicit KinematicTrkBands(const DaidalusParameters& parameters);
+
   KinematicTrkBands(const KinematicTrkBands& b);
 
+  KinematicTrkBands(KinematicTrkBands&& b) = default;
+  KinematicTrkBands& operator=(const KinematicTrkBands& b) = default;
+  KinematicTrkBands& operator=(KinematicTrkBands&& b) = default;
+
   void setTurnRate(double val);
 
   void setBankAngle(double val);
@@ -49,6 +57,19 @@ class KinematicTrkBands : public KinematicRealBands {
 
   void none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac, double B, double T,
       const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+
+  bool exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+      double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const;
+
+  protected:
+  bool instantaneous_bands() const;
+
+  double instantaneous_value(const Velocity& v) const;
+
+  Velocity instantaneous_velocity(const Velocity& v, double val) const;
+
+  void critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+      double D, double H, double B, double T) const;
   };
 
 }
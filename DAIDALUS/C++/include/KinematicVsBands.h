@@ -8,6 +8,7 @@
 #define KINEMATICVSBANDS_H_
 
 #include "KinematicRealBands.h"
+#include "DaidalusParameters.h"
 #include "Detection3D.h"
 #include "TrafficState.h"
 #include "OwnshipState.h"
@@ -26,8 +27,15 @@ class KinematicVsBands : public KinematicRealBands {
   public:
   KinematicVsBands();
 
+  /** Bands with the parameters of the given object */
+  explicit KinematicVsBands(const DaidalusParameters& parameters);
+
   KinematicVsBands(const KinematicVsBands& b);
 
+  KinematicVsBands(KinematicVsBands&& b) = default;
+  KinematicVsBands& operator=(const KinematicVsBands& b) = default;
+  KinematicVsBands& operator=(KinematicVsBands&& b) = default;
+
   void setVerticalAcceleration(double val);
 
   double getVerticalAcceleration() const;
@@ -42,6 +50,21 @@ class KinematicVsBands : public KinematicRealBands {
   
   void none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac, double B, double T,
       const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const;
+
+  bool exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+      double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const;
+
+  protected:
+  double max_ownship_vs(const OwnshipState& ownship) const;
+
+  bool instantaneous_bands() const;
+
+  double instantaneous_value(const Velocity& v) const;
+
+  Velocity instantaneous_velocity(const Velocity& v, double val) const;
+
+  void critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+      double D, double H, double B, double T) const;
   };
 
 }
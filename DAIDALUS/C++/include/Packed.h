@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef PACKED_H_
+#define PACKED_H_
+
+#include "Util.h"
+#include <cmath>
+#include <cstring>
+
+/*
+ * DAIDALUS_PACKED is 1 when the compiler supports the vector extensions used by Packed (GCC and Clang).
+ * Otherwise, functions that use Packed fall back to plain loops.
+ */
+#if defined(__GNUC__)
+#define DAIDALUS_PACKED 1
+#else
+#define DAIDALUS_PACKED 0
+#endif
+
+/*
+ * DAIDALUS_PACKED_X86 is 1 on x86-64 with GCC or Clang. Then, packed functions are compiled for AVX2 and the
+ * default instruction set (SSE2), and the version that matches the processor is selected at run time (see
+ * packed_run). Elsewhere, packed functions are compiled for the default instruction set only.
+ */
+#if DAIDALUS_PACKED && defined(__x86_64__)
+#define DAIDALUS_PACKED_X86 1
+#else
+#define DAIDALUS_PACKED_X86 0
+#endif
+
+#if DAIDALUS_PACKED
+
+/*
+ * Functions of Packed are always inlined, so that they are compiled with the instruction set of the
+ * function that calls them.
+ */
+#define DAIDALUS_PACKED_INLINE inline __attribute__((always_inline))
+
+/*
+ * Since functions are inlined, packed values never cross a function call, and the warnings of GCC about the
+ * calling convention of vectors (-Wpsabi) do not apply. They are disabled for the definitions of this header
+ * only, so that they still apply to the files that include it. Source files that instantiate functions of
+ * Packed disable them too, since GCC reports them where the functions are instantiated.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace larcfm {
+
+/** Vector types of Packed<N>, for N = 2, 4, and 8 */
+template <int N> class PackedTypes;
+
+template <> class PackedTypes<2> {
+public:
+  typedef double vec __attribute__((vector_size(16)));
+};
+
+template <> class PackedTypes<4> {
+public:
+  typedef double vec __attribute__((vector_size(32)));
+};
+
+template <> class PackedTypes<8> {
+public:
+  typedef double vec __attribute__((vector_size(64)));
+};
+
+/**
+ * N double values that are processed in lock step, with the functions of Vect2, Vect3, Horizontal, and
+ * WCV_Vertical written on packed values. Vectors are given by their components, each one a packed value,
+ * so that lane j of the components is the j-th vector. The functions do the same floating point
+ * operations as their scalar counterparts, in the same order, so that each lane yields the same result as
+ * the scalar function. Masks are vectors of integers whose lanes are -1 (true) or 0 (false).<p>
+ *
+ * N is 2, 4, or 8, which fit in SSE2, AVX2, and AVX-512 registers, respectively. Packed values that are wider
+ * than the registers of the processor are split by the compiler. packed_run uses 2 or 4 lanes.
+ */
+template <int N>
+class Packed {
+public:
+  typedef typename PackedTypes<N>::vec vec;
+  typedef decltype(vec() < vec()) mask;
+
+  static DAIDALUS_PACKED_INLINE vec load(const double* p) {
+    vec r;
+    std::memcpy(&r,p,sizeof(vec));
+    return r;
+  }
+
+  static DAIDALUS_PACKED_INLINE vec broadcast(double x) {
+    return vec() + x;
+  }
+
+  /** Stores 1 in out[j] if lane j of m is true, otherwise 0 */
+  static DAIDALUS_PACKED_INLINE void store(char* out, const mask& m) {
+    for (int j = 0; j < N; ++j) {
+      out[j] = m[j] != 0;
+    }
+  }
+
+  static DAIDALUS_PACKED_INLINE vec select(const mask& m, const vec& a, const vec& b) {
+    return m ? a : b;
+  }
+
+  static DAIDALUS_PACKED_INLINE vec abs(const vec& a) {
+    return a < 0 ? -a : a;
+  }
+
+  /** Same as std::min, lane by lane */
+  static DAIDALUS_PACKED_INLINE vec min(const vec& a, const vec& b) {
+    return b < a ? b : a;
+  }
+
+  /** Same as std::max, lane by lane */
+  static DAIDALUS_PACKED_INLINE vec max(const vec& a, const vec& b) {
+    return a < b ? b : a;
+  }
+
+  static DAIDALUS_PACKED_INLINE vec sqrt(const vec& a) {
+    vec r;
+    for (int j = 0; j < N; ++j) {
+      r[j] = std::sqrt(a[j]);
+    }
+    return r;
+  }
+
+  /** Same as Util::sqrt_safe */
+  static DAIDALUS_PACKED_INLINE vec sqrt_safe(const vec& a) {
+    return sqrt(max(a,broadcast(0)));
+  }
+
+  /** Same as Util::almost_equals(a,0) with PRECISION_DEFAULT */
+  static DAIDALUS_PACKED_INLINE mask almost_zero(const vec& a) {
+    return abs(a) < 1.0E-13;
+  }
+
+  /** Same as Vect2::dot */
+  static DAIDALUS_PACKED_INLINE vec dot(const vec& x1, const vec& y1, const vec& x2, const vec& y2) {
+    return x1*x2 + y1*y2;
+  }
+
+  /** Same as Vect3::dot */
+  static DAIDALUS_PACKED_INLINE vec dot(const vec& x1, const vec& y1, const vec& z1, const vec& x2, const vec& y2, const vec& z2) {
+    return x1*x2 + y1*y2 + z1*z2;
+  }
+
+  /** Same as Vect2::sqv */
+  static DAIDALUS_PACKED_INLINE vec sqv(const vec& x, const vec& y) {
+    return dot(x,y,x,y);
+  }
+
+  /** Same as Vect2::norm */
+  static DAIDALUS_PACKED_INLINE vec norm(const vec& x, const vec& y) {
+    return sqrt_safe(sqv(x,y));
+  }
+
+  /** Same as Vect2::ScalAdd and Vect3::ScalAdd, component by component: k*u+v */
+  static DAIDALUS_PACKED_INLINE vec scalAdd(const vec& k, const vec& u, const vec& v) {
+    return k*u + v;
+  }
+
+  /** Same as Horizontal::tcpa, NaN when v is zero */
+  static DAIDALUS_PACKED_INLINE vec tcpa(const vec& sx, const vec& sy, const vec& vx, const vec& vy) {
+    return select((vx == 0) & (vy == 0), broadcast(NaN), -dot(sx,sy,vx,vy)/sqv(vx,vy));
+  }
+
+  /** Same as Horizontal::dcpa */
+  static DAIDALUS_PACKED_INLINE vec dcpa(const vec& sx, const vec& sy, const vec& vx, const vec& vy) {
+    vec t = tcpa(sx,sy,vx,vy);
+    return norm(scalAdd(t,vx,sx),scalAdd(t,vy,sy));
+  }
+
+  /** Same as WCV_Vertical::vertical_WCV */
+  static DAIDALUS_PACKED_INLINE mask vertical_WCV(double ZTHR, double TCOA, const vec& sz, const vec& vz) {
+    return (abs(sz) <= ZTHR) | (~(vz == 0) & (sz*vz <= 0) & (-sz/vz <= TCOA));
+  }
+
+  /**
+   * Same as WCV_Vertical::vertical_WCV_interval. The interval of lane j is [time_in[j],time_out[j]], it is
+   * empty when time_in[j] > time_out[j].
+   */
+  static DAIDALUS_PACKED_INLINE void vertical_WCV_interval(double ZTHR, double TCOA, double B, double T, const vec& sz, const vec& vz,
+      vec& time_in, vec& time_out) {
+    mask level = almost_zero(vz);
+    vec act_H = max(broadcast(ZTHR),abs(vz)*TCOA);
+    vec sign = select(vz >= 0,broadcast(1),broadcast(-1));
+    vec tentry = (-sign*act_H-sz)/vz;
+    vec texit = (sign*ZTHR-sz)/vz;
+    mask none = (level & ~(abs(sz) <= ZTHR)) | (~level & ((T < tentry) | (texit < B)));
+    time_in = select(level,broadcast(B),max(broadcast(B),tentry));
+    time_out = select(level,broadcast(T),min(broadcast(T),texit));
+    time_in = select(none,broadcast(T),time_in);
+    time_out = select(none,broadcast(B),time_out);
+  }
+
+};
+
+/**
+ * Lanes of the packed values used by packed_run: 4 when the processor supports AVX2, otherwise 2.<p>
+ *
+ * AVX-512 processors also use 4 lanes. GCC lowers the 8-lane masks of the inlined functions of Packed<8>
+ * to scalar code before they reach a function compiled for AVX-512, which makes 8 lanes slower than the
+ * plain loops.
+ */
+inline int packed_lanes() {
+#if DAIDALUS_PACKED_X86
+  static const int lanes = __builtin_cpu_supports("avx2") ? 4 : 2;
+  return lanes;
+#else
+  return 2;
+#endif
+}
+
+#if DAIDALUS_PACKED_X86
+template <class F>
+__attribute__((target("avx2"))) void packed_run_avx2(F& f) {
+  f.template run<4>();
+  // GCC only clears the upper part of vector registers at -O2 and above. This avoids penalties in
+  // the SSE code of the caller.
+  __builtin_ia32_vzeroupper();
+}
+#endif
+
+/**
+ * Calls f.run<N>(), where N is packed_lanes(), compiled for the instruction set of N lanes. F::run
+ * should be declared DAIDALUS_PACKED_INLINE, so that it is compiled for that instruction set.
+ */
+template <class F>
+void packed_run(F& f) {
+#if DAIDALUS_PACKED_X86
+  if (packed_lanes() == 4) {
+    packed_run_avx2(f);
+    return;
+  }
+#endif
+  f.template run<2>();
+}
+
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+#endif
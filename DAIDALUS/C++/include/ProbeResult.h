@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef PROBERESULT_H_
+#define PROBERESULT_H_
+
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Result of probing a candidate ownship velocity against the traffic of a Daidalus object: whether
+ * the velocity leads to a conflict, the earliest time of violation, and the indices, in the aircraft
+ * list of the Daidalus object, of the aircraft in conflict.
+ */
+class ProbeResult {
+
+private:
+  double time_in;
+  std::vector<int> aircraft;
+
+public:
+  ProbeResult();
+
+  /**
+   * Removes all the aircraft. The storage of the list of aircraft is kept.
+   */
+  void clear();
+
+  /**
+   * Adds the aircraft at index ac, which is in conflict from time t.
+   */
+  void add(int ac, double t);
+
+  /**
+   * @return true if the velocity leads to a conflict with some aircraft.
+   */
+  bool conflict() const;
+
+  /**
+   * @return earliest time of violation [s], relative to the time of the probe. It is positive infinity when
+   * there is no conflict.
+   */
+  double getTimeIn() const;
+
+  /**
+   * @return indices of the aircraft in conflict, in increasing order.
+   */
+  const std::vector<int>& getAircraft() const;
+
+  std::string toString() const;
+
+};
+
+}
+
+#endif
@@ -14,6 +14,8 @@
 
 #include "EuclideanProjection.h"
 #include "LatLonAlt.h"
+#include "ErrorLog.h"
+#include <mutex>
 #include <string>
 
  /*
@@ -29,11 +31,15 @@
 
 /**
  * A static holding class for universal projection information.  All projection objects should be retrieved from this class.
+ * In C++, the projection type is chosen at compile time (see EuclideanProjection.h) and the static members are constant,
+ * so that projections can be created concurrently from several threads. Each OwnshipState keeps its own projection.
  */
 class Projection {
    private:
-	   static EuclideanProjection projection;
-	   static ProjectionType ptype;
+	   static const EuclideanProjection projection;
+	   static const ProjectionType ptype;
+	   static ErrorLog error;
+	   static std::mutex mutex;
    public:
 	   /**
 	    * Returns a new projection for the current type with the given reference point.
@@ -77,10 +83,21 @@ class Projection {
 
 
 	   /**
-	    * Set the projection to a new type.  This is a global change.
+	    * Set the projection to a new type.  This is a global change. In C++, this has no effect: when t is not
+	    * the current type, a warning is added to the messages of Projection (see hasMessage).
 	    */
 	   static void setProjectionType(ProjectionType t);
 
+	   /**
+	    * Returns true if Projection has warnings, e.g., from setProjectionType.
+	    */
+	   static bool hasMessage();
+
+	   /**
+	    * Returns the warnings of Projection and clears them.
+	    */
+	   static std::string getMessage();
+
 	   /**
 	    * Given a string representation of a ProjectionType, return the ProjectionType
 	    */
@@ -133,7 +150,7 @@ class Projection {
 
    /**
     * \deprecated {Use Projection:: version.}
-    * Set the projection to a new type.  This is a global change.
+    * Set the projection to a new type.  This is a global change. In C++, this has no effect (see Projection::setProjectionType).
     */
    void setProjectionType(ProjectionType t);
 
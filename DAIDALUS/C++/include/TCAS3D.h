@@ -12,6 +12,8 @@
 #include "Vect2.h"
 #include "TCASTable.h"
 #include "ConflictData.h"
+#include "TrafficArrays.h"
+#include <atomic>
 
 namespace larcfm {
 class TCAS3D : public Detection3D {
@@ -23,8 +25,26 @@ private:
   void print_PVS_input(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
   void print_PVS_output(double time_in, double time_out, const std::string& comment) const;
 
+  /* Values of the TCAS table at the sensitivity level of an ownship altitude */
+  class RAThresholds {
+  public:
+    bool usehmdf;
+    double TAU;
+    double DMOD;
+    double HMD;
+    double ZTHR;
+  };
+
+  RAThresholds thresholds(double alt) const;
+
+  bool TCASII_RA(const RAThresholds& th, const Vect3& so, const Vect3& vo, const Vect3& si, const Vect3& vi) const;
+
+  /* Same as RA3D_interval(so,vo,si,vi,B,T).conflict(), without computing the time of minimum tau */
+  bool RA3D_conflict(const RAThresholds& th, const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
+
 public:
-  static bool pvsCheck;
+  /** When set, inputs and outputs are printed in PVS syntax. It may be set while other threads use detectors. */
+  static std::atomic<bool> pvsCheck;
   
   /** Constructor that uses the default TCAS tables. */
   TCAS3D();
@@ -52,10 +72,16 @@ public:
 
   ConflictData conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
+  bool anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const;
+
+  bool anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const;
+
   TCAS3D* copy() const;
   TCAS3D* make() const;
 
   std::string getSimpleClassName() const;
+  int getClassTag() const;
+  int getSuperClassTag() const;
 
   std::string toString() const;
 
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace larcfm {
+
+/**
+ * A fixed set of worker threads that run groups of independent tasks. The thread that
+ * calls run() also runs tasks while it waits for its group to complete. Therefore, a task may
+ * call run() on the same pool to run nested tasks without risk of deadlock.<p>
+ *
+ * A pool with 0 workers runs all the tasks in the calling thread.
+ */
+class ThreadPool {
+
+public:
+
+  /**
+   * Construct a pool with the given number of worker threads.
+   */
+  explicit ThreadPool(int workers);
+
+  ~ThreadPool();
+
+  /**
+   * @return number of worker threads, not counting threads that call run()
+   */
+  int size() const;
+
+  /**
+   * Run all tasks and return when all of them have completed. Tasks are not
+   * run in any particular order.
+   */
+  void run(const std::vector<std::function<void()> >& tasks);
+
+private:
+  struct Task {
+    const std::function<void()>* f;
+    int* pending;
+  };
+
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator=(const ThreadPool&);
+
+  void worker();
+  void finish(int* pending);
+
+  std::vector<std::thread> workers;
+  std::deque<Task> queue;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool stop;
+};
+
+}
+
+#endif
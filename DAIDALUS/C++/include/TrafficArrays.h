@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef TRAFFICARRAYS_H_
+#define TRAFFICARRAYS_H_
+
+#include "Vect3.h"
+#include "Velocity.h"
+#include "TrafficState.h"
+#include "OwnshipState.h"
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Positions and velocities of a list of traffic aircraft in the Euclidean frame of an ownship,
+ * stored as one array per coordinate. Traffic states are projected once, when the arrays are set,
+ * so that detectors can check all the aircraft in tight loops over contiguous data. The i-th
+ * element of each array corresponds to the i-th aircraft of the list used to set the arrays.
+ */
+class TrafficArrays {
+
+public:
+  /** Number of aircraft checked in one pass of the batched loops of a detector */
+  static const int BLOCK = 64;
+
+  std::vector<double> sx;
+  std::vector<double> sy;
+  std::vector<double> sz;
+  std::vector<double> vx;
+  std::vector<double> vy;
+  std::vector<double> vz;
+
+  TrafficArrays();
+
+  TrafficArrays(const OwnshipState& ownship, const std::vector<TrafficState>& traffic);
+
+  /**
+   * Sets the arrays to the projections of traffic in the frame of ownship.
+   */
+  void set(const OwnshipState& ownship, const std::vector<TrafficState>& traffic);
+
+  void clear();
+
+  int size() const;
+
+  bool isEmpty() const;
+
+  /**
+   * Position of the i-th aircraft
+   */
+  Vect3 s(int i) const;
+
+  /**
+   * Velocity of the i-th aircraft
+   */
+  Velocity v(int i) const;
+
+};
+
+}
+
+#endif
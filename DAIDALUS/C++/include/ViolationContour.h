@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef VIOLATIONCONTOUR_H_
+#define VIOLATIONCONTOUR_H_
+
+#include "Detection3D.h"
+#include "OwnshipState.h"
+#include "TrafficState.h"
+#include "Interval.h"
+#include "Position.h"
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Violation contour of an aircraft with respect to the ownship, in track space. A region of the contour
+ * is a maximal interval of ownship tracks, at the current ground speed and vertical speed of the ownship,
+ * that lead to a conflict with the aircraft in a time interval [B,T]. For each region, the contour provides
+ * a list of sampled tracks in increasing order and, for each of them, the positions where the ownship enters
+ * and exits the violation volume. These positions are the end points of the lines that draw the region.<p>
+ *
+ * The contour is computed without a fixed sampling of the tracks. When the detector provides violation bounds
+ * (see Detection3D::horizontalViolationBound), the tracks in conflict are contained in the tracks of a
+ * cylinder, whose boundaries are computed in closed form by CriticalVectors. Tracks outside these boundaries
+ * are not checked. Otherwise, all tracks are candidate. For CDCylinder, the violation volume is the cylinder,
+ * and the regions are exactly the intervals of tracks computed in closed form. For other detectors, candidate
+ * tracks are sampled at most every maximum step, and the boundaries of the regions are refined by bisection up
+ * to the track tolerance. As with a fixed sampling, a region that is narrower than the maximum step may be
+ * missed. In both cases, samples are added where the polylines of entry or exit positions deviate from the
+ * contour more than the distance tolerance.
+ */
+class ViolationContour {
+
+private:
+  class Sample {
+  public:
+    double trk;
+    bool conflict;
+    Vect3 s_in;
+    Vect3 s_out;
+    double time_in;
+    double time_out;
+  };
+
+  class Region {
+  public:
+    double low;
+    double up;
+    std::vector<double> trks;
+    std::vector<Position> entries;
+    std::vector<Position> exits;
+  };
+
+  double trk_tol;
+  double dist_tol;
+  double max_step;
+  std::vector<Region> regions;
+  int calls;
+
+  Sample sample(double trk, const Detection3D* detector, const OwnshipState& own, const Vect3& si, const Velocity& vi,
+      double B, double T);
+
+  void refine(const Sample& a, const Sample& b, const Detection3D* detector, const OwnshipState& own,
+      const Vect3& si, const Velocity& vi, double B, double T, std::vector<Sample>& samples);
+
+  bool chord_ok(const Sample& a, const Sample& m, const Sample& b) const;
+
+  /** Appends smp to the last region */
+  void append(const Sample& smp, const OwnshipState& own);
+
+  static bool candidate_arcs(const Detection3D* detector, const OwnshipState& own, const Vect3& si, const Velocity& vi,
+      double B, double T, std::vector<Interval>& arcs);
+
+public:
+
+  /** Default tolerances: 0.1 deg in track, 50 m in distance, and maximum step of 1 deg */
+  ViolationContour();
+
+  /**
+   * Contour with given track tolerance trk_tol [rad], distance tolerance dist_tol [m], and maximum step between
+   * samples max_step [rad]. The maximum step is not used for CDCylinder, whose regions are computed in closed form.
+   */
+  ViolationContour(double trk_tol, double dist_tol, double max_step);
+
+  /**
+   * Computes the violation contour of the aircraft ac with respect to own, for the detector in [B,T]. The
+   * previous contour is discarded.
+   */
+  void compute(const Detection3D* detector, const OwnshipState& own, const TrafficState& ac, double B, double T);
+
+  void clear();
+
+  /** Number of regions */
+  int size() const;
+
+  /**
+   * Interval of tracks [rad] of region i. The lower bound is in [0,2pi). The upper bound is greater than 2pi
+   * when the region contains north. The region is all tracks when the upper bound is 2pi more than the
+   * lower bound. For CDCylinder, the bounds may be tangent tracks, which are not in the sampled tracks.
+   */
+  Interval getTrackInterval(int i) const;
+
+  /** Sampled tracks [rad] of region i, in increasing order */
+  const std::vector<double>& getTracks(int i) const;
+
+  /** Positions where the ownship enters the violation volume, one per sampled track of region i */
+  const std::vector<Position>& getEntries(int i) const;
+
+  /** Positions where the ownship exits the violation volume, one per sampled track of region i */
+  const std::vector<Position>& getExits(int i) const;
+
+  /** Number of calls to the conflict detection of the detector in the last computation */
+  int detectorCalls() const;
+
+  double getTrackTolerance() const;
+  void setTrackTolerance(double trk);
+  double getDistanceTolerance() const;
+  void setDistanceTolerance(double d);
+  double getMaxStep() const;
+  void setMaxStep(double trk);
+
+  std::string toString() const;
+
+};
+
+}
+
+#endif
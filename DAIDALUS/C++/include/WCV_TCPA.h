@@ -12,11 +12,12 @@
 #include "Velocity.h"
 #include "WCVTable.h"
 #include "WCV_tvar.h"
+#include "WCV_kernel.h"
 #include "LossData.h"
 #include <string>
 
 namespace larcfm {
-class WCV_TCPA : public WCV_tvar {
+class WCV_TCPA : public WCV_tvar_kernel<WCV_TCPA_tvar> {
 
 
 public:
@@ -27,10 +28,6 @@ public:
   /** Constructor that specifies a particular instance of the WCV tables. */
   WCV_TCPA(const WCVTable& tab);
 
-  double horizontal_tvar(const Vect2& s, const Vect2& v) const;
-
-  LossData horizontal_WCV_interval(double T, const Vect2& s, const Vect2& v) const ;
-
 //  bool conflict(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
 //  // The semantics of this function is "Time of Minimum Modified Tau"
@@ -46,6 +43,8 @@ public:
 
   std::string getSimpleClassName() const;
 
+  int getClassTag() const;
+
   bool contains(const Detection3D* cd) const;
 
 };
@@ -20,6 +20,22 @@ public:
   static bool vertical_WCV(double ZTHR, double TCOA, double sz, double vz);
   void vertical_WCV_interval(double ZTHR, double TCOA, double B, double T, double sz, double vz);
 
+  /**
+   * Batched vertical_WCV of n aircraft, where the relative altitude and vertical speed of aircraft j, for
+   * j in [0,n), are z-(t*vz[j]+sz[j]) and wz-vz[j]. keep[j] is set to the result of aircraft j.
+   * The function uses packed arithmetic, see Packed.h.
+   */
+  static void vertical_WCV_block(char* keep, int n, double ZTHR, double TCOA, double z, double wz, double t,
+      const double* sz, const double* vz);
+
+  /**
+   * Batched vertical_WCV_interval of n aircraft, with the same relative altitudes and vertical speeds as
+   * vertical_WCV_block. keep[j] is set to false, unless keep[j] is true and the interval of aircraft j
+   * is not empty.
+   */
+  static void vertical_WCV_interval_block(char* keep, int n, double ZTHR, double TCOA, double B, double T,
+      double z, double wz, double t, const double* sz, const double* vz);
+
 };
 }
 #endif
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef WCV_KERNEL_H_
+#define WCV_KERNEL_H_
+
+#include "Detection3D.h"
+#include "Vect3.h"
+#include "Velocity.h"
+#include "WCV_tvar.h"
+#include "WCV_Vertical.h"
+#include "ConflictData.h"
+#include "LossData.h"
+#include "TrafficArrays.h"
+#include "Util.h"
+#include <cfloat>
+#include <algorithm>
+#include <cmath>
+
+namespace larcfm {
+
+/**
+ * Time variable of WCV_TAUMOD. A policy class of WCV_kernel: horizontal_tvar and horizontal_WCV_interval
+ * take the relative horizontal position (sx,sy) and velocity (vx,vy) as plain values.
+ */
+class WCV_TAUMOD_tvar {
+public:
+
+  // Time variable is Modified Tau
+  static double horizontal_tvar(double DTHR, double sqs, double sdotv) {
+    double taumod = -1;
+    if (sdotv < 0)
+      return (Util::sq(DTHR)-sqs)/sdotv;
+    return taumod;
+  }
+
+  static void horizontal_WCV_interval(double DTHR, double TTHR, double T, double sx, double sy, double vx, double vy,
+      double& time_in, double& time_out) {
+    time_in = T;
+    time_out = 0;
+    double sqs = sx*sx+sy*sy;
+    double sdotv = sx*vx+sy*vy;
+    double sqD = Util::sq(DTHR);
+    double a = vx*vx+vy*vy;
+    double b = 2*sdotv+TTHR*a;
+    double c = sqs+TTHR*sdotv-sqD;
+    if (Util::almost_equals(a,0) && sqs <= sqD) { // [CAM] Changed from == to almost_equals to mitigate numerical problems
+      time_in = 0;
+      time_out = T;
+      return;
+    }
+    if (sqs <= sqD) {
+      time_in = 0;
+      time_out = std::min(T,Util::root2b(a,sdotv,sqs-sqD,1));
+      return;
+    }
+    double discr = Util::sq(b)-4*a*c;
+    if (sdotv >= 0 || discr < 0)
+      return;
+    double t = (-b - std::sqrt(discr))/(2*a);
+    if (sqD*a-Util::sq(sx*vy-sy*vx) >= 0 && t <= T) {
+      time_in = std::max(0.0,t);
+      time_out = std::min(T,Util::root2b(a,sdotv,sqs-sqD,1));
+    }
+  }
+
+};
+
+/**
+ * Time variable of WCV_TCPA. A policy class of WCV_kernel.
+ */
+class WCV_TCPA_tvar {
+public:
+
+  // Time variable is Modified Tau
+  static double horizontal_tvar(double DTHR, double sqs, double sdotv) {
+    double TCPA = -1;
+    if (sdotv < 0)
+      return (Util::sq(DTHR)-sqs)/sdotv;
+    return TCPA;
+  }
+
+  static void horizontal_WCV_interval(double DTHR, double TTHR, double T, double sx, double sy, double vx, double vy,
+      double& time_in, double& time_out) {
+    time_in = T;
+    time_out = 0;
+    double sqs = sx*sx+sy*sy;
+    double sqv = vx*vx+vy*vy;
+    double sdotv = sx*vx+sy*vy;
+    double sqD = Util::sq(DTHR);
+    if (Util::almost_equals(sqv,0) && sqs <= sqD) { // [CAM] Changed from == to almost_equals to mitigate numerical problems
+      time_in = 0;
+      time_out = T;
+      return;
+    }
+    if (Util::almost_equals(sqv,0)) // [CAM] Changed from == to almost_equals to mitigate numerical problems
+      return;
+    if (sqs <= sqD) {
+      time_in = 0;
+      time_out = std::min(T,Util::root2b(sqv,sdotv,sqs-sqD,1));
+      return;
+    }
+    if (sdotv > 0)
+      return;
+    double tcpa = (vx != 0 || vy != 0) ? -sdotv/sqv : NaN;
+    double cx = tcpa*vx+sx;
+    double cy = tcpa*vy+sy;
+    if (Util::sqrt_safe(cx*cx+cy*cy) > DTHR)
+      return;
+    double Delta = sqD*sqv-Util::sq(sx*vy-sy*vx);
+    if (Delta < 0 && tcpa - TTHR > T)
+      return;
+    if (Delta < 0) {
+      time_in = std::max(0.0,tcpa-TTHR);
+      time_out = std::min(T,tcpa);
+      return;
+    }
+    double tmin = std::min(Util::root2b(sqv,sdotv,sqs-sqD,-1),tcpa-TTHR);
+    if (tmin > T)
+      return;
+    time_in = std::max(0.0,tmin);
+    time_out = std::min(T,Util::root2b(sqv,sdotv,sqs-sqD,1));
+  }
+
+};
+
+/**
+ * Well-clear violation and conflict detection of WCV_tvar, specialized at compile time on the
+ * time variable Tvar. The computations are the same as the ones of WCV_tvar and WCV_Vertical, but
+ * they are written on plain values, so that they can be inlined in the loops of the detectors and
+ * do not go through virtual calls. Output for PVS checks is not supported by these functions.
+ */
+template <class Tvar>
+class WCV_kernel {
+public:
+
+  static bool horizontal_WCV(double DTHR, double TTHR, double sx, double sy, double vx, double vy) {
+    double sqs = sx*sx+sy*sy;
+    if (Util::sqrt_safe(sqs) <= DTHR) return true;
+    double sdotv = sx*vx+sy*vy;
+    double tcpa = (vx != 0 || vy != 0) ? -sdotv/(vx*vx+vy*vy) : NaN;
+    double cx = tcpa*vx+sx;
+    double cy = tcpa*vy+sy;
+    if (Util::sqrt_safe(cx*cx+cy*cy) <= DTHR) {
+      double tvar = Tvar::horizontal_tvar(DTHR,sqs,sdotv);
+      return 0  <= tvar && tvar <= TTHR;
+    }
+    return false;
+  }
+
+  static bool vertical_WCV(double ZTHR, double TCOA, double sz, double vz) {
+    return std::abs(sz) <= ZTHR ||
+        (vz != 0 && sz*vz <= 0 && -sz/vz <= TCOA);
+  }
+
+  static void vertical_WCV_interval(double ZTHR, double TCOA, double B, double T, double sz, double vz,
+      double& time_in, double& time_out) {
+    time_in = B;
+    time_out = T;
+    if (Util::almost_equals(vz,0) && std::abs(sz) <= ZTHR) // [CAM] Changed from == to almost_equals to mitigate numerical problems
+      return;
+    if (Util::almost_equals(vz,0)) { // [CAM] Changed from == to almost_equals to mitigate numerical problems
+      time_in = T;
+      time_out = B;
+      return;
+    }
+    double act_H = std::max(ZTHR,std::abs(vz)*TCOA);
+    int sign = vz >= 0 ? 1 : -1;
+    double tentry = (-sign*act_H-sz)/vz;
+    double texit = (sign*ZTHR-sz)/vz;
+    if (T < tentry || texit < B) {
+      time_in = T;
+      time_out = B;
+      return;
+    }
+    time_in = std::max(B,tentry);
+    time_out = std::min(T,texit);
+  }
+
+  static bool violation(const WCVTable& table, double sx, double sy, double sz, double vx, double vy, double vz) {
+    return horizontal_WCV(table.getDTHR(),table.getTTHR(),sx,sy,vx,vy) &&
+        vertical_WCV(table.getZTHR(),table.getTCOA(),sz,vz);
+  }
+
+  /**
+   * Same as WCV_tvar::WCV_interval, where (sx,sy,sz) and (vx,vy,vz) are the relative position and velocity
+   * of the ownship with respect to the intruder. The returned times are the ones of the LossData computed by
+   * WCV_tvar::WCV_interval.
+   */
+  static void WCV_interval(const WCVTable& table, double B, double T,
+      double sx, double sy, double sz, double vx, double vy, double vz, double& time_in, double& time_out) {
+    if (T <= B) {
+      T = DBL_MAX;
+    }
+    time_in = T;
+    time_out = B;
+    double vin, vout;
+    vertical_WCV_interval(table.getZTHR(),table.getTCOA(),B,T,sz,vz,vin,vout);
+    if (vin > vout) {
+      return;
+    }
+    double stepx = vin*vx+sx;
+    double stepy = vin*vy+sy;
+    if (Util::almost_equals(vin,vout)) { // [CAM] Changed from == to almost_equals to mitigate numerical problems
+      if (horizontal_WCV(table.getDTHR(),table.getTTHR(),stepx,stepy,vx,vy)) {
+        time_in = vout; // Same as LossData(vin,vout)
+        time_out = vout;
+      }
+      return;
+    }
+    double hin, hout;
+    Tvar::horizontal_WCV_interval(table.getDTHR(),table.getTTHR(),vout-vin,stepx,stepy,vx,vy,hin,hout);
+    if (Util::almost_equals(hin,hout)) { // Same as LossData(hin,hout)
+      hin = hout;
+    }
+    time_in = hin + vin;
+    time_out = hout + vin;
+    if (Util::almost_equals(time_in,time_out)) { // Same as LossData(time_in,time_out)
+      time_in = time_out;
+    }
+  }
+
+  static bool conflict(const WCVTable& table, double B, double T,
+      double sx, double sy, double sz, double vx, double vy, double vz) {
+    double time_in, time_out;
+    WCV_interval(table,B,T,sx,sy,sz,vx,vy,vz,time_in,time_out);
+    return time_in < time_out;
+  }
+
+};
+
+/**
+ * WCV_tvar detector whose violation and conflict checks, including the batched ones over traffic
+ * arrays, are done by the inlined functions of WCV_kernel<Tvar>. Checks go through the generic
+ * functions of WCV_tvar when WCV_tvar::pvsCheck is set.
+ */
+template <class Tvar>
+class WCV_tvar_kernel : public WCV_tvar {
+
+public:
+
+  double horizontal_tvar(const Vect2& s, const Vect2& v) const {
+    return Tvar::horizontal_tvar(table.getDTHR(),s.sqv(),s.dot(v));
+  }
+
+  LossData horizontal_WCV_interval(double T, const Vect2& s, const Vect2& v) const {
+    double time_in, time_out;
+    Tvar::horizontal_WCV_interval(table.getDTHR(),table.getTTHR(),T,s.x,s.y,v.x,v.y,time_in,time_out);
+    return LossData(time_in,time_out);
+  }
+
+  bool violation(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi) const {
+    return WCV_kernel<Tvar>::violation(table,so.x-si.x,so.y-si.y,so.z-si.z,vo.x-vi.x,vo.y-vi.y,vo.z-vi.z);
+  }
+
+  bool conflict(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const {
+    if (pvsCheck) {
+      return WCV_tvar::conflict(so,vo,si,vi,B,T);
+    }
+    return WCV_kernel<Tvar>::conflict(table,B,T,so.x-si.x,so.y-si.y,so.z-si.z,vo.x-vi.x,vo.y-vi.y,vo.z-vi.z);
+  }
+
+  bool anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const {
+    double DTHR = table.getDTHR();
+    double TTHR = table.getTTHR();
+    double ZTHR = table.getZTHR();
+    double TCOA = table.getTCOA();
+    int n = traffic.size();
+    char keep[TrafficArrays::BLOCK];
+    for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+      int m = std::min(n-i0,TrafficArrays::BLOCK);
+      const double* sx = traffic.sx.data()+i0;
+      const double* sy = traffic.sy.data()+i0;
+      const double* sz = traffic.sz.data()+i0;
+      const double* vx = traffic.vx.data()+i0;
+      const double* vy = traffic.vy.data()+i0;
+      const double* vz = traffic.vz.data()+i0;
+      WCV_Vertical::vertical_WCV_block(keep,m,ZTHR,TCOA,so.z,vo.z,t,sz,vz);
+      for (int j = 0; j < m; ++j) {
+        if (keep[j] && WCV_kernel<Tvar>::horizontal_WCV(DTHR,TTHR,so.x-(t*vx[j]+sx[j]),so.y-(t*vy[j]+sy[j]),
+            vo.x-vx[j],vo.y-vy[j])) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  bool anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const {
+    if (pvsCheck) {
+      return WCV_tvar::anyConflict(so,vo,traffic,t,B,T);
+    }
+    int n = traffic.size();
+    char keep[TrafficArrays::BLOCK];
+    // Same upper bound as WCV_kernel::WCV_interval
+    double Tv = T <= B ? DBL_MAX : T;
+    for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+      int m = std::min(n-i0,TrafficArrays::BLOCK);
+      reachable_block(keep,i0,m,so,vo,traffic,t,B,T,table.getDTHR(),table.getTTHR(),table.getZTHR(),table.getTCOA());
+      const double* sx = traffic.sx.data()+i0;
+      const double* sy = traffic.sy.data()+i0;
+      const double* sz = traffic.sz.data()+i0;
+      const double* vx = traffic.vx.data()+i0;
+      const double* vy = traffic.vy.data()+i0;
+      const double* vz = traffic.vz.data()+i0;
+      // Aircraft whose vertical interval is empty are not in conflict
+      WCV_Vertical::vertical_WCV_interval_block(keep,m,table.getZTHR(),table.getTCOA(),B,Tv,so.z,vo.z,t,sz,vz);
+      for (int j = 0; j < m; ++j) {
+        if (keep[j] && WCV_kernel<Tvar>::conflict(table,B,T,so.x-(t*vx[j]+sx[j]),so.y-(t*vy[j]+sy[j]),so.z-(t*vz[j]+sz[j]),
+            vo.x-vx[j],vo.y-vy[j],vo.z-vz[j])) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+};
+
+}
+#endif
@@ -13,7 +13,9 @@
 #include "WCVTable.h"
 #include "ConflictData.h"
 #include "LossData.h"
+#include "TrafficArrays.h"
 #include <string>
+#include <atomic>
 
 namespace larcfm {
 class WCV_tvar : public Detection3D {
@@ -23,7 +25,8 @@ protected:
   std::string id;
 
 public:
-  static bool pvsCheck;
+  /** When set, inputs and outputs are printed in PVS syntax. It may be set while other threads use detectors. */
+  static std::atomic<bool> pvsCheck;
 
   /** This returns a copy of the object's internal table */
   WCVTable getWCVTable();
@@ -67,10 +70,18 @@ public:
 
   ConflictData conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
+  bool anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const;
+
+  bool anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const;
+
   LossData WCV3D(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
   LossData WCV_interval(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
+  double horizontalViolationBound(double vh) const;
+
+  double verticalViolationBound(double vz) const;
+
 private:
   void print_PVS_input(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
@@ -91,6 +102,7 @@ public:
   virtual std::string getSimpleSuperClassName() const {
     return "WCV_tvar";
   }
+  virtual int getSuperClassTag() const;
 
   std::string getIdentifier() const;
 
@@ -61,9 +61,11 @@ void AlertThresholds::setAlertingTime(double val) {
 }
 
 std::pair<bool,double> AlertThresholds::alerting(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi) const {
-  bool alert = false;
-  ConflictData det = detector->conflictDetection(so,vo,si,vi,0,alerting_time);
-  alert = det.conflict(duration_thr);
+  return alerting(detector->conflictDetection(so,vo,si,vi,0,alerting_time));
+}
+
+std::pair<bool,double> AlertThresholds::alerting(const ConflictData& det) const {
+  bool alert = det.conflict(duration_thr);
   if (alerting_time == 0) {
     alert &= det.getTimeIn() == 0;
   }
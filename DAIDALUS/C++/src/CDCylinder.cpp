@@ -13,11 +13,15 @@
  */
 
 #include "CDCylinder.h"
+#include "Detection3DRegistry.h"
 #include "LossData.h"
 #include "CD3DTable.h"
 #include "LossData.h"
 #include "ConflictData.h"
+#include "TrafficArrays.h"
+#include "Util.h"
 #include <cmath>
+#include <algorithm>
 
 #include "CD3D.h"
 #include "format.h"
@@ -144,6 +148,64 @@ ConflictData CDCylinder::conflictDetection(const Vect3& so, const Velocity& vo,
   return conflictDetection(so,vo,si,vi,table.D, table.H, B, T);
 }
 
+/**
+ * Same as CD3D::lossOfSep for each aircraft. The loop is branch free and is vectorized by the compiler.
+ */
+bool CDCylinder::anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const {
+  double D2 = Util::sq(table.D);
+  double H = table.H;
+  int n = traffic.size();
+  for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+    int m = std::min(n-i0,TrafficArrays::BLOCK);
+    const double* sx = traffic.sx.data()+i0;
+    const double* sy = traffic.sy.data()+i0;
+    const double* sz = traffic.sz.data()+i0;
+    const double* vx = traffic.vx.data()+i0;
+    const double* vy = traffic.vy.data()+i0;
+    const double* vz = traffic.vz.data()+i0;
+    int los = 0;
+    for (int j = 0; j < m; ++j) {
+      double x = so.x-(t*vx[j]+sx[j]);
+      double y = so.y-(t*vy[j]+sy[j]);
+      double z = so.z-(t*vz[j]+sz[j]);
+      los |= (x*x+y*y < D2) & (std::abs(z) < H);
+    }
+    if (los) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Only the aircraft that can reach the protected zone within [B,T] are checked.
+ */
+bool CDCylinder::anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const {
+  int n = traffic.size();
+  char keep[TrafficArrays::BLOCK];
+  for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+    int m = std::min(n-i0,TrafficArrays::BLOCK);
+    reachable_block(keep,i0,m,so,vo,traffic,t,B,T,table.D,0,table.H,0);
+    for (int j = 0; j < m; ++j) {
+      if (keep[j]) {
+        Velocity vi = traffic.v(i0+j);
+        if (conflict(so,vo,vi.ScalAdd(t,traffic.s(i0+j)),vi,B,T)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+double CDCylinder::horizontalViolationBound(double vh) const {
+  return table.D;
+}
+
+double CDCylinder::verticalViolationBound(double vz) const {
+  return table.H;
+}
+
 CDCylinder* CDCylinder::make() const {
   return new CDCylinder();
 }
@@ -178,6 +240,14 @@ std::string CDCylinder::getSimpleClassName() const {
   return "CDCylinder";
 }
 
+int CDCylinder::getClassTag() const {
+  return Detection3DRegistry::TAG_CDCYLINDER;
+}
+
+int CDCylinder::getSuperClassTag() const {
+  return Detection3DRegistry::TAG_CDCYLINDER;
+}
+
 std::string CDCylinder::toString() const {
   return (id == "" ? "" : id+" = ")+getSimpleClassName()+": {"+table.toString()+"}";
 }
@@ -191,14 +261,14 @@ void CDCylinder::setIdentifier(const std::string& s) {
 }
 
 bool CDCylinder::equals(Detection3D* d) const {
-  if (!larcfm::equals(getCanonicalClassName(), d->getCanonicalClassName())) return false;
+  if (getClassTag() != d->getClassTag()) return false;
   if (!larcfm::equals(id, d->getIdentifier())) return false;
   if (!table.equals(((CDCylinder*)d)->table)) return false;
   return true;
 }
 
 bool CDCylinder::contains(const Detection3D* cd) const {
-  if (larcfm::equals(getCanonicalClassName(), cd->getCanonicalClassName())) {
+  if (getClassTag() == cd->getClassTag()) {
     CDCylinder* d = (CDCylinder*)cd;
     return table.D >= d->table.D && table.H >= d->table.H;
   }
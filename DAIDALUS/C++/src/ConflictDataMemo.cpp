@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "ConflictDataMemo.h"
+#include "Detection3D.h"
+#include "ConflictData.h"
+#include <map>
+
+namespace larcfm {
+
+ConflictDataMemo::Key::Key(int a, const Detection3D* d, double b, double e) :
+    ac(a), detector(d), B(b), T(e) {
+}
+
+bool ConflictDataMemo::Key::operator<(const Key& k) const {
+  if (ac != k.ac) return ac < k.ac;
+  if (detector != k.detector) return detector < k.detector;
+  if (B != k.B) return B < k.B;
+  return T < k.T;
+}
+
+ConflictDataMemo::ConflictDataMemo() {
+  time = 0;
+}
+
+bool ConflictDataMemo::lookup(int ac, const Detection3D* detector, double t, double B, double T, ConflictData& data) const {
+  if (t != time) {
+    return false;
+  }
+  std::map<Key,ConflictData>::const_iterator it = table.find(Key(ac,detector,B,T));
+  if (it == table.end()) {
+    return false;
+  }
+  data = it->second;
+  return true;
+}
+
+void ConflictDataMemo::store(int ac, const Detection3D* detector, double t, double B, double T, const ConflictData& data) {
+  if (t != time) {
+    table.clear();
+    time = t;
+  }
+  table[Key(ac,detector,B,T)] = data;
+}
+
+void ConflictDataMemo::clear() {
+  table.clear();
+}
+
+int ConflictDataMemo::size() const {
+  return table.size();
+}
+
+}
@@ -11,6 +11,7 @@
 #include "CD3D.h"
 #include "ACCoRDConfig.h"
 #include "CDCylinder.h"
+#include "Detection3DRegistry.h"
 #include "ConflictData.h"
 #include "LossData.h"
 #include "format.h"
@@ -18,6 +19,9 @@
 #include "NoneUrgencyStrategy.h"
 #include <string>
 #include <vector>
+#include <functional>
+#include <algorithm>
+#include <utility>
 
 namespace larcfm {
 
@@ -31,8 +35,9 @@ const char*  Daidalus::VERSION = "0.991";
  * No alerts, aircraft, or wind fields are initially defined.
  */
 Daidalus::Daidalus() : error("Daidalus") {
-  parameters = DaidalusParameters(DefaultDaidalusParameters::getParameters());
+  parameters = *DefaultDaidalusParameters::getSnapshot();
   detector = new WCV_TAUMOD();
+  detector_class = detector->getCanonicalClassName();
   init();
 }
 
@@ -41,8 +46,9 @@ Daidalus::Daidalus() : error("Daidalus") {
  * No Alerts, aircraft, or wind fields are initially defined.
  */
 Daidalus::Daidalus(Detection3D* d) : error("Daidalus") {
-  parameters = DaidalusParameters(DefaultDaidalusParameters::getParameters());
+  parameters = *DefaultDaidalusParameters::getSnapshot();
   detector = d->copy();
+  detector_class = detector->getCanonicalClassName();
   set_parameters_from_detector();
   init();
 }
@@ -54,6 +60,7 @@ Daidalus::Daidalus(Detection3D* d) : error("Daidalus") {
 Daidalus::Daidalus(const Daidalus& dda) : error("Daidalus") {
   parameters = DaidalusParameters(dda.parameters);
   detector = dda.detector->copy();
+  detector_class = dda.detector_class;
   urgency_strat = dda.urgency_strat->copy();
   wind_vector = dda.wind_vector;
   acs = std::vector<TrafficState>();
@@ -61,6 +68,7 @@ Daidalus::Daidalus(const Daidalus& dda) : error("Daidalus") {
   times = std::vector<double>();
   times.insert(times.end(),dda.times.begin(),dda.times.end());
   info = dda.info;
+  pruned_aircraft = 0;
   for (int i=0; i < (int) dda.alertor.size(); ++i) {
     alertor.push_back(AlertThresholds(dda.alertor[i]));
   }
@@ -79,6 +87,8 @@ void Daidalus::init() {
   info = AlertInfo();
   alertor.clear();
   alertor = MOPS();
+  pruned_aircraft = 0;
+  memo.clear();
 }
 
 /**
@@ -101,6 +111,7 @@ void Daidalus::setAircraftList(const std::vector<TrafficState>& acl,double time)
  * Clear aircraft list, reset current time and wind vector.
  */
 void Daidalus::reset() {
+  memo.clear();
   acs.clear();
   times.clear();
   wind_vector = Velocity::ZEROV;
@@ -117,16 +128,17 @@ DaidalusParameters Daidalus::getParameters() const {
  * @return a reference to this object's Detectoin3D instance.
  */
 Detection3D* Daidalus::getDetector()  const {
+  memo.clear();
   return detector;
 }
 
 void Daidalus::set_parameters_from_detector() {
-  if (equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar")) {
+  if (detector->getSuperClassTag() == Detection3DRegistry::TAG_WCV_TVAR) {
     parameters.setDTHR(((WCV_tvar *)detector)->getDTHR());
     parameters.setZTHR(((WCV_tvar *)detector)->getZTHR());
     parameters.setTTHR(((WCV_tvar *)detector)->getTTHR());
     parameters.setTCOA(((WCV_tvar *)detector)->getTCOA());
-  } else if (equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.CDCylinder")) {
+  } else if (detector->getSuperClassTag() == Detection3DRegistry::TAG_CDCYLINDER) {
     parameters.setD(((CDCylinder *)detector)->getHorizontalSeparation());
     parameters.setH(((CDCylinder *)detector)->getVerticalSeparation());
   }
@@ -136,11 +148,26 @@ void Daidalus::set_parameters_from_detector() {
  * Set this object's Detection3D method to be a copy of the given method.
  */
 void Daidalus::setDetector(const Detection3D* d) {
+  memo.clear();
   delete detector;
   detector = d->copy();
+  detector_class = detector->getCanonicalClassName();
   set_parameters_from_detector();
 }
 
+bool Daidalus::setDetector(const std::string& classname) {
+  Detection3D* d = Detection3DRegistry::make(classname);
+  if (d == NULL) {
+    error.addError(ErrorLog::NOT_FOUND,"setDetector","Detector % is not registered",classname);
+    return false;
+  }
+  delete detector;
+  detector = d;
+  detector_class = detector->getCanonicalClassName();
+  set_detector_from_parameters();
+  return true;
+}
+
 std::vector<AlertThresholds> Daidalus::PT5() {
   std::vector<AlertThresholds> alertor;
 
@@ -236,7 +263,7 @@ int Daidalus::numberOfAircraft() const {
  */
 std::string Daidalus::aircraftName(int i) {
   if (i < 0 || i >= acs.size()) {
-    error.addError("aircraftName: invalid index "+Fm0(i));
+    error.addError(ErrorLog::INVALID_INDEX,"aircraftName: invalid index %",i);
     return TrafficState::INVALID.getId();
   }
   return acs[i].getId();
@@ -253,6 +280,7 @@ Velocity Daidalus::getWindField() const {
  * Set wind vector (common to all aircraft)
  */
 void Daidalus::setWindField(const Velocity& wind) {
+  memo.clear();
   for (int i=0; i < acs.size(); ++i) {
     TrafficState ac = acs[i];
     double dt = getCurrentTime()-times[i];
@@ -269,6 +297,7 @@ void Daidalus::setWindField(const Velocity& wind) {
  * Clear all aircraft and set ownship state and current time. Velocity vector is ground velocity.
  */
 void Daidalus::setOwnshipState(const std::string& id, const Position& pos, const Velocity& vel, double time) {
+  memo.clear();
   acs.clear();
   acs.push_back(TrafficState(id,pos,vel.Sub(wind_vector)));
   times.clear();
@@ -293,6 +322,7 @@ int Daidalus::addTrafficState(const std::string& id, const Position& pos, const
     setOwnshipState(id,pos,vel,time);
     return 0;
   } else {
+    memo.clear();
     double dt = getCurrentTime()-time;
     Velocity vt = vel.Sub(wind_vector);
     Position pt = pos.linear(vt,dt);
@@ -335,6 +365,7 @@ int Daidalus::addTrafficState(const TrafficState& ac) {
  */
 void Daidalus::resetOwnship(int i) {
   if (0 < i && i < acs.size()) {
+    memo.clear();
     TrafficState ac = acs[0];
     acs[0] = acs[i];
     acs[i] = ac;
@@ -372,6 +403,7 @@ int Daidalus::aircraftIndex(const std::string& name) const {
  * Clears alert types and thresholds
  **/
 void Daidalus::clearAlertThresholds() {
+  memo.clear();
   alertor.clear();
 }
 
@@ -389,6 +421,7 @@ int Daidalus::mostSevereAlertThresholds() {
 
 bool Daidalus::setAlertThresholds(int alert_type, const AlertThresholds& alert) {
   if (0 < alert_type && alert_type <= alertor.size()) {
+    memo.clear();
     alertor[alert_type-1] = alert;
     return true;
   }
@@ -400,6 +433,7 @@ bool Daidalus::setAlertThresholds(int alert_type, const AlertThresholds& alert)
  * number.
  */
 int Daidalus::addAlertThresholds(const AlertThresholds& alert) {
+  memo.clear();
   alertor.push_back(alert);
   return alertor.size();
 }
@@ -411,7 +445,7 @@ AlertThresholds Daidalus::getAlertThresholds(int alert_type)  const {
   if (0 < alert_type && alert_type <= alertor.size()) {
     return alertor[alert_type-1];
   } else {
-    error.addError("getAlertThresholds: invalid alert type '"+Fm0(alert_type)+"'");
+    error.addError(ErrorLog::INVALID_VALUE,"getAlertThresholds: invalid alert type '%'",alert_type);
     return AlertThresholds(detector);
   }
 }
@@ -420,6 +454,7 @@ AlertThresholds Daidalus::getAlertThresholds(int alert_type)  const {
  * Set all alert thresholds for thresholds-based alerting logic.
  */
 void Daidalus::setAlertor(const std::vector<AlertThresholds>& al) {
+  memo.clear();
   alertor.clear();
   for (int i=0; i < al.size(); ++i) {
     alertor.push_back(AlertThresholds(al[i]));
@@ -441,26 +476,51 @@ AlertInfo Daidalus::lastAlertInfo() const {
  * Computes alert type for given aircraft states using different set of threshold values.
  * @return 0 if no alert thresholds are violated.
  */
-int Daidalus::thresholds_alerting(const OwnshipState& own, const TrafficState& ac) {
+int Daidalus::thresholds_alerting(int ac, double time, const OwnshipState& own, const TrafficState& aci) {
   Vect3 so = own.get_s();
   Velocity vo = own.get_v();
-  Position pi = ac.getPosition();
+  Position pi = aci.getPosition();
   Vect3 si = own.pos_to_s(pi);
-  Velocity vi = own.vel_to_v(pi,ac.getVelocity());
+  Velocity vi = own.vel_to_v(pi,aci.getVelocity());
   info = AlertInfo();
+  Vect3 s = so.Sub(si);
+  Vect3 v = vo.Sub(vi);
+  bool pruned = true;
   for (int i=alertor.size(); i > 0; --i) {
-    std::pair<bool,double> alertVal = alertor[i-1].alerting(so,vo,si,vi);
+    if (alertor[i-1].getDetector()->unreachable(s,v.vect2().norm(),std::abs(v.z),alertor[i-1].getAlertingTime())) {
+      continue;
+    }
+    pruned = false;
+    ConflictData det = conflict_detection(ac,time,alertor[i-1].getDetector(),own,aci,0,alertor[i-1].getAlertingTime());
+    std::pair<bool,double> alertVal = alertor[i-1].alerting(det);
     if (alertVal.first) {
       info = AlertInfo(i,so,vo,si,vi,alertVal.second);
       return i;
     }
   }
+  if (pruned) {
+    ++pruned_aircraft;
+  }
   return 0;
 }
 
+int Daidalus::prunedAircraftCount() const {
+  return pruned_aircraft;
+}
+
+ConflictData Daidalus::conflict_detection(int ac, double time, const Detection3D* det, const OwnshipState& own, const TrafficState& aci,
+    double B, double T) {
+  ConflictData data;
+  if (!memo.lookup(ac,det,time,B,T,data)) {
+    Position pi = aci.getPosition();
+    data = det->conflictDetection(own.get_s(),own.get_v(),own.pos_to_s(pi),own.vel_to_v(pi,aci.getVelocity()),B,T);
+    memo.store(ac,det,time,B,T,data);
+  }
+  return data;
+}
+
 double Daidalus::last_time_to_maneuver(const OwnshipState& own, const TrafficState& ac, const TrafficState& repac, double t2v) {
-  KinematicBands bands = KinematicBands(detector);
-  bands.setParameters(parameters);
+  KinematicBands bands = KinematicBands(detector,parameters);
   bands.setCriteriaAircraft(repac.getId());
   double pivot_green = 0;
   double pivot_red = t2v;
@@ -489,29 +549,25 @@ double Daidalus::last_time_to_maneuver(const OwnshipState& own, const TrafficSta
  * Computes alert type for given aircraft states using different kinematic bands.
  * @return 0 if no alert thresholds are violated.
  */
-int Daidalus::bands_alerting(const OwnshipState& own, const TrafficState& ac, const TrafficState& repac) {
-  KinematicBands bands = KinematicBands(detector);
-  bands.setParameters(parameters);
+int Daidalus::bands_alerting(int ac, double time, const OwnshipState& own, const TrafficState& aci, const TrafficState& repac) {
+  KinematicBands bands = KinematicBands(detector,parameters);
   bands.setCriteriaAircraft(repac.getId());
   bands.disableRecoveryBands();
   bands.enableImplicitBands();
   bands.setOwnship(own);
-  bands.addTraffic(ac);
+  bands.addTraffic(aci);
   if ((!isEnabledTrackAlerting() || bands.trackLength() == 0) &&
       (!isEnabledGroundSpeedAlerting() || bands.groundSpeedLength() == 0) &&
       (!isEnabledVerticalSpeedAlerting() || bands.verticalSpeedLength() == 0)) {
     // There are no bands of any type
     return 0;
   } else {
-    Position pi = ac.getPosition();
     Vect3 so = own.get_s();
-    Velocity vo = own.get_v();
-    Vect3 si = own.pos_to_s(pi);
-    Velocity vi = own.vel_to_v(pi,ac.getVelocity());
-    ConflictData det = detector->conflictDetection(so,vo,si,vi,0,alerting_time());
+    Vect3 si = own.pos_to_s(aci.getPosition());
+    ConflictData det = conflict_detection(ac,time,detector,own,aci,0,alerting_time());
     if (det.conflict()) {
       double time2warning = parameters.isEnabledWarningWhenRecovery() ?
-          last_time_to_maneuver(own,ac,repac,det.getTimeIn()) : det.getTimeIn();
+          last_time_to_maneuver(own,aci,repac,det.getTimeIn()) : det.getTimeIn();
       if (time2warning <= parameters.getTimeToWarningThreshold()) {
         return 4; // Warning
       } else {
@@ -547,10 +603,10 @@ int Daidalus::bands_alerting(const OwnshipState& own, const TrafficState& ac, co
  */
 int Daidalus::alertingAt(int ac, double time) {
   if (ac <= 0 || ac >= acs.size()) {
-    error.addError("alerting: aircraft index "+Fm0(ac)+" out of bounds");
+    error.addError(ErrorLog::INVALID_INDEX,"alerting: aircraft index % out of bounds",ac);
     return -1;
   } else if (time < getCurrentTime() || time > getCurrentTime()+getLookaheadTime()) {
-    error.addError("alerting: time "+Fm0(time)+" not in time horizon for aircraft "+Fm0(ac));
+    error.addError(ErrorLog::INVALID_TIME,"alerting: time % not in time horizon for aircraft %",time,ac);
     return -1;
   }
   double dt = time-getCurrentTime();
@@ -558,9 +614,9 @@ int Daidalus::alertingAt(int ac, double time) {
   TrafficState aci = acs[ac].linearProjection(dt);
   if (parameters.isEnabledBandsAlerting()) {
     TrafficState repac = mostUrgentAircraftAt(time);
-    return bands_alerting(own,aci,repac);
+    return bands_alerting(ac,time,own,aci,repac);
   } else {
-    return thresholds_alerting(own,aci);
+    return thresholds_alerting(ac,time,own,aci);
   }
 }
 
@@ -578,7 +634,7 @@ double Daidalus::getCurrentTime() const {
  */
 int Daidalus::alerting(int ac) {
   if (acs.empty()) {
-    error.addError("alerting: traffic list is empty");
+    error.addError(ErrorLog::NO_DATA,"alerting: traffic list is empty");
     return -1;
   }
   return alertingAt(ac,getCurrentTime());
@@ -591,11 +647,11 @@ int Daidalus::alerting(int ac) {
  */
 ConflictData Daidalus::timeIntervalOfViolationAt(int ac, double time) {
   if (acs.size() < 1) {
-    error.addError("timeIntervalOfViolationAt: no aircraft information has been loaded");
+    error.addError(ErrorLog::NO_DATA,"timeIntervalOfViolationAt: no aircraft information has been loaded");
     return ConflictData();
   }
   if (time < getCurrentTime() || time > getCurrentTime()+getLookaheadTime()) {
-    error.addError("timeIntervalOfViolationAt: time not within ownship plan limits");
+    error.addError(ErrorLog::INVALID_TIME,"timeIntervalOfViolationAt: time not within ownship plan limits");
     return ConflictData();
   }
   if (ac <= 0 || ac >= acs.size() || time < getCurrentTime() ||time > getCurrentTime()+getLookaheadTime())
@@ -603,9 +659,7 @@ ConflictData Daidalus::timeIntervalOfViolationAt(int ac, double time) {
   double dt = time-getCurrentTime();
   OwnshipState own = OwnshipState(acs[0].linearProjection(dt));
   TrafficState aci = acs[ac].linearProjection(dt);
-  Position pi = aci.getPosition();
-  Velocity vi = aci.getVelocity();
-  return detector->conflictDetection(own.get_s(),own.get_v(),own.pos_to_s(pi),own.vel_to_v(pi,vi),0,getLookaheadTime());
+  return conflict_detection(ac,time,detector,own,aci,0,getLookaheadTime());
 }
 
 /**
@@ -623,11 +677,11 @@ ConflictData Daidalus::timeIntervalOfViolation(int ac) {
  */
 double Daidalus::timeToViolationAt(int ac, double time) {
   if (acs.size() < 1) {
-    error.addError("timeToViolationAt: no aircraft information has been loaded");
+    error.addError(ErrorLog::NO_DATA,"timeToViolationAt: no aircraft information has been loaded");
     return -1;
   }
   if (time < getCurrentTime() || time > getCurrentTime()+getLookaheadTime()) {
-    error.addError("timeToViolationAt: time not within ownship plan limits");
+    error.addError(ErrorLog::INVALID_TIME,"timeToViolationAt: time not within ownship plan limits");
     return -1;
   }
   ConflictData det = timeIntervalOfViolationAt(ac,time);
@@ -646,6 +700,69 @@ double Daidalus::timeToViolation(int ac) {
   return timeToViolationAt(ac,getCurrentTime());
 }
 
+bool Daidalus::timeIntervalsOfViolationAt(double time, std::vector<ConflictData>& data) {
+  if (acs.size() < 1) {
+    error.addError(ErrorLog::NO_DATA,"timeIntervalsOfViolationAt: no aircraft information has been loaded");
+    data.clear();
+    return false;
+  }
+  if (time < getCurrentTime() || time > getCurrentTime()+getLookaheadTime()) {
+    error.addError(ErrorLog::INVALID_TIME,"timeIntervalsOfViolationAt: time not within ownship plan limits");
+    data.clear();
+    return false;
+  }
+  double dt = time-getCurrentTime();
+  OwnshipState own = OwnshipState(acs[0].linearProjection(dt));
+  data.resize(acs.size());
+  data[0] = ConflictData();
+  for (int ac = 1; ac < (int) acs.size(); ++ac) {
+    TrafficState aci = acs[ac].linearProjection(dt);
+    data[ac] = conflict_detection(ac,time,detector,own,aci,0,getLookaheadTime());
+  }
+  return true;
+}
+
+bool Daidalus::timeIntervalsOfViolation(std::vector<ConflictData>& data) {
+  return timeIntervalsOfViolationAt(getCurrentTime(),data);
+}
+
+bool Daidalus::timesToViolationAt(double time, std::vector<double>& t2v) {
+  if (acs.size() < 1) {
+    error.addError(ErrorLog::NO_DATA,"timesToViolationAt: no aircraft information has been loaded");
+    t2v.clear();
+    return false;
+  }
+  if (time < getCurrentTime() || time > getCurrentTime()+getLookaheadTime()) {
+    error.addError(ErrorLog::INVALID_TIME,"timesToViolationAt: time not within ownship plan limits");
+    t2v.clear();
+    return false;
+  }
+  double dt = time-getCurrentTime();
+  OwnshipState own = OwnshipState(acs[0].linearProjection(dt));
+  t2v.resize(acs.size());
+  t2v[0] = -1;
+  for (int ac = 1; ac < (int) acs.size(); ++ac) {
+    TrafficState aci = acs[ac].linearProjection(dt);
+    ConflictData det = conflict_detection(ac,time,detector,own,aci,0,getLookaheadTime());
+    t2v[ac] = det.conflict() ? det.getTimeIn() : -1;
+  }
+  return true;
+}
+
+bool Daidalus::timesToViolation(std::vector<double>& t2v) {
+  return timesToViolationAt(getCurrentTime(),t2v);
+}
+
+bool Daidalus::violationContour(int ac, ViolationContour& contour) {
+  if (ac <= 0 || ac >= (int) acs.size()) {
+    error.addError(ErrorLog::INVALID_INDEX,"violationContour: aircraft index % out of bounds",ac);
+    contour.clear();
+    return false;
+  }
+  contour.compute(detector,getOwnshipState(),getTrafficState(ac),0,getLookaheadTime());
+  return true;
+}
+
 /**
  * @return kinematic bands at given time. Computation of bands is lazy, they are only compute when needed.
  * @param time - The time the bands will be calculated for. This must be a time within current time and
@@ -653,17 +770,16 @@ double Daidalus::timeToViolation(int ac) {
  */
 KinematicBands Daidalus::getKinematicBandsAt(double time) {
   if (acs.size() < 1) {
-    error.addError("getKinematicBandsAt: no aircraft information has been loaded");
+    error.addError(ErrorLog::NO_DATA,"getKinematicBandsAt: no aircraft information has been loaded");
     return KinematicBands();
   }
   if (time < getCurrentTime() || time > getCurrentTime()+getLookaheadTime()) {
-    error.addError("getKinematicBandsAt: time "+Fm0(time)+" not within ownship plan limits");
+    error.addError(ErrorLog::INVALID_TIME,"getKinematicBandsAt: time % not within ownship plan limits",time);
     return KinematicBands();
   }
   double dt = time-getCurrentTime();
   OwnshipState own = OwnshipState(acs[0].linearProjection(dt));
-  KinematicBands bands = KinematicBands(detector); // this is safe because KinematicBands will make its own copy
-  bands.setParameters(parameters);
+  KinematicBands bands = KinematicBands(detector,parameters); // this is safe because KinematicBands will make its own copy
   bands.setOwnship(own);
   for (int ac = 1; ac < acs.size(); ++ac) {
     TrafficState aci = acs[ac].linearProjection(dt);
@@ -675,7 +791,7 @@ KinematicBands Daidalus::getKinematicBandsAt(double time) {
 
 OwnshipState Daidalus::getOwnshipStateAt(double time) const {
   if (acs.size() < 1) {
-    error.addError("getOwnshipAt: no ownship state information");
+    error.addError(ErrorLog::NO_DATA,"getOwnshipAt: no ownship state information");
     return OwnshipState::INVALID;
   }
   double dt = time-getCurrentTime();
@@ -691,7 +807,7 @@ OwnshipState Daidalus::getOwnshipState() const {
 
 TrafficState Daidalus::getTrafficStateAt(int ac, double time) const {
   if (ac < 0 || ac >= acs.size()) {
-    error.addError("getTrafficAt: no traffic state information");
+    error.addError(ErrorLog::NO_DATA,"getTrafficAt: no traffic state information");
     return TrafficState::INVALID;
   }
   if (ac == 0) {
@@ -728,7 +844,7 @@ std::string Daidalus::trafficToPVS(int ac, int prec) const {
 std::string Daidalus::aircraftListAtToPVS(double time, int prec) const {
   std::string s = "";
   if (acs.size() < 1) {
-    error.addError("trafficAtToPVS: no aircraft information has been loaded");
+    error.addError(ErrorLog::NO_DATA,"trafficAtToPVS: no aircraft information has been loaded");
     return s;
   }
   s += "(: "+ownshipAtToPVS(time,prec);
@@ -747,18 +863,137 @@ std::string Daidalus::aircraftListToPVS(int prec) const {
  */
 KinematicBands Daidalus::getKinematicBands() {
   if (acs.size() == 0) {
-    error.addError("getKinematicBands: traffic list is empty");
+    error.addError(ErrorLog::NO_DATA,"getKinematicBands: traffic list is empty");
     return KinematicBands();
   }
   return getKinematicBandsAt(getCurrentTime());
 }
 
+/**
+ * Computes alerts and kinematic bands for each aircraft at the given indices, when this aircraft
+ * is considered the ownship and all the other aircraft are traffic. All aircraft are evaluated at
+ * current time. When pool is not NULL, the aircraft are evaluated in parallel.
+ */
+std::vector<DaidalusResult> Daidalus::getResults(const std::vector<int>& indices, ThreadPool* pool) {
+  std::vector<int> valid;
+  for (int k = 0; k < (int) indices.size(); ++k) {
+    if (indices[k] < 0 || indices[k] >= (int) acs.size()) {
+      error.addError(ErrorLog::INVALID_INDEX,"getResults: invalid index %",indices[k]);
+    } else {
+      valid.push_back(indices[k]);
+    }
+  }
+  std::vector<DaidalusResult> results(valid.size());
+  if (pool == NULL) {
+    for (int k = 0; k < (int) valid.size(); ++k) {
+      ownship_result(valid[k],results[k]);
+    }
+  } else {
+    // Each task only reads this object and writes its own result
+    std::vector<std::function<void()> > tasks;
+    for (int k = 0; k < (int) valid.size(); ++k) {
+      tasks.push_back([this,&results,&valid,k]() { ownship_result(valid[k],results[k]); });
+    }
+    pool->run(tasks);
+  }
+  return results;
+}
+
+/**
+ * Computes alerts and kinematic bands for every aircraft, when this aircraft is considered
+ * the ownship and all the other aircraft are traffic.
+ */
+std::vector<DaidalusResult> Daidalus::getAllResults(ThreadPool* pool) {
+  std::vector<int> indices;
+  for (int i = 0; i < (int) acs.size(); ++i) {
+    indices.push_back(i);
+  }
+  return getResults(indices,pool);
+}
+
+bool Daidalus::probeVelocities(const std::vector<Velocity>& velocities, std::vector<ProbeResult>& results, ThreadPool* pool) {
+  if (acs.size() < 1) {
+    error.addError(ErrorLog::NO_DATA,"probeVelocities: no aircraft information has been loaded");
+    results.clear();
+    return false;
+  }
+  OwnshipState own = getOwnshipState();
+  std::vector<TrafficState> traffic(acs.begin()+1,acs.end());
+  TrafficArrays arrays(own,traffic);
+  int n = velocities.size();
+  std::vector<Velocity> vos(n);
+  for (int k = 0; k < n; ++k) {
+    // Candidates are ground velocities, as the velocities of setOwnshipState
+    vos[k] = own.vel_to_v(own.getPosition(),velocities[k].Sub(wind_vector));
+  }
+  results.resize(n);
+  Vect3 so = own.get_s();
+  if (pool == NULL) {
+    probe_tile(so,vos,arrays,0,n,results);
+  } else {
+    // Each task only reads this object and writes the results of its own tile
+    std::vector<std::function<void()> > tasks;
+    for (int k0 = 0; k0 < n; k0 += PROBE_TILE) {
+      int k1 = std::min(k0+PROBE_TILE,n);
+      tasks.push_back([this,&so,&vos,&arrays,&results,k0,k1]() { probe_tile(so,vos,arrays,k0,k1,results); });
+    }
+    pool->run(tasks);
+  }
+  return true;
+}
+
+void Daidalus::probe_tile(const Vect3& so, const std::vector<Velocity>& vos, const TrafficArrays& traffic, int k0, int k1,
+    std::vector<ProbeResult>& results) const {
+  double T = getLookaheadTime();
+  for (int k = k0; k < k1; ++k) {
+    results[k].clear();
+  }
+  for (int i0 = 0; i0 < traffic.size(); i0 += TrafficArrays::BLOCK) {
+    int i1 = std::min(i0+TrafficArrays::BLOCK,traffic.size());
+    for (int k = k0; k < k1; ++k) {
+      const Velocity& vo = vos[k];
+      for (int i = i0; i < i1; ++i) {
+        Vect3 si = traffic.s(i);
+        Velocity vi = traffic.v(i);
+        Vect3 v = vo.Sub(vi);
+        if (detector->unreachable(so.Sub(si),v.vect2().norm(),std::abs(v.z),T)) {
+          continue;
+        }
+        ConflictData det = detector->conflictDetection(so,vo,si,vi,0,T);
+        if (det.conflict()) {
+          // Aircraft i of traffic is at index i+1 of the aircraft list
+          results[k].add(i+1,det.getTimeIn());
+        }
+      }
+    }
+  }
+}
+
+void Daidalus::ownship_result(int i, DaidalusResult& result) const {
+  // Aircraft states are already projected to current time, so the ownship is exchanged
+  // without the projection done by resetOwnship. Current time is given by times[0], which is kept.
+  Daidalus dda = Daidalus(*this);
+  dda.acs[0] = acs[i];
+  dda.acs[i] = acs[0];
+  std::vector<int> alerts(acs.size(),-1);
+  for (int j = 0; j < (int) acs.size(); ++j) {
+    int ac = j == 0 ? i : j == i ? 0 : j;
+    if (ac > 0) {
+      alerts[j] = dda.alerting(ac);
+    }
+  }
+  KinematicBands bands = dda.getKinematicBands();
+  bands.computeAllBands();
+  // Moving, like assignment and unlike copy construction, keeps the bands already computed, without copying them
+  result = DaidalusResult(i,acs[i].getId(),alerts,std::move(bands));
+}
+
 /**
  * @return DTHR threshold in internal units.
  */
 double Daidalus::getDTHR()  const {
-  if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-    error.addWarning("[getDTHR] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+  if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+    error.addWarning(ErrorLog::WRONG_DETECTOR,"getDTHR","Detector % is not an instance of WCV detector",detector_class);
   }
   return parameters.getDTHR();
 }
@@ -767,8 +1002,8 @@ double Daidalus::getDTHR()  const {
  * @return ZTHR threshold in internal units.
  */
 double Daidalus::getZTHR()  const {
-  if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-    error.addWarning("[getZTHR] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+  if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+    error.addWarning(ErrorLog::WRONG_DETECTOR,"getZTHR","Detector % is not an instance of WCV detector",detector_class);
   }
   return parameters.getZTHR();
 }
@@ -777,8 +1012,8 @@ double Daidalus::getZTHR()  const {
  * @return TTHR threshold in seconds.
  */
 double Daidalus::getTTHR()  const {
-  if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-    error.addWarning("[getTTHR] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+  if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+    error.addWarning(ErrorLog::WRONG_DETECTOR,"getTTHR","Detector % is not an instance of WCV detector",detector_class);
   }
   return parameters.getTTHR();
 }
@@ -787,8 +1022,8 @@ double Daidalus::getTTHR()  const {
  * @return TCOA threshold in seconds.
  */
 double Daidalus::getTCOA()  const {
-  if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-    error.addWarning("[getTCOA] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+  if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+    error.addWarning(ErrorLog::WRONG_DETECTOR,"getTCOA","Detector % is not an instance of WCV detector",detector_class);
   }
   return parameters.getTCOA();
 }
@@ -797,8 +1032,8 @@ double Daidalus::getTCOA()  const {
  * @return D threshold in internal units.
  */
 double Daidalus::getD()  const {
-  if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.CDCylinder"))) {
-    error.addWarning("[getD] Detector "+detector->getCanonicalClassName()+" is not an instance of CD3D detector");
+  if (detector->getSuperClassTag() != Detection3DRegistry::TAG_CDCYLINDER) {
+    error.addWarning(ErrorLog::WRONG_DETECTOR,"getD","Detector % is not an instance of CD3D detector",detector_class);
   }
   return parameters.getD();
 }
@@ -807,8 +1042,8 @@ double Daidalus::getD()  const {
  * @return H threshold in internal units.
  */
 double Daidalus::getH()  const {
-  if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.CDCylinder"))) {
-    error.addWarning("[getH] Detector "+detector->getCanonicalClassName()+" is not an instance of CD3D detector");
+  if (detector->getSuperClassTag() != Detection3DRegistry::TAG_CDCYLINDER) {
+    error.addWarning(ErrorLog::WRONG_DETECTOR,"getH","Detector % is not an instance of CD3D detector",detector_class);
   }
   return parameters.getH();
 }
@@ -818,9 +1053,10 @@ double Daidalus::getH()  const {
  */
 void Daidalus::setDTHR(double val) {
   if (error.isPositive("setD",val)) {
-    if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-      error.addWarning("[setDTHR] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+    if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+      error.addWarning(ErrorLog::WRONG_DETECTOR,"setDTHR","Detector % is not an instance of WCV detector",detector_class);
     } else {
+      memo.clear();
       ((WCV_tvar*)detector)->setDTHR(val);
     }
     parameters.setDTHR(val);
@@ -832,9 +1068,10 @@ void Daidalus::setDTHR(double val) {
  */
 void Daidalus::setZTHR(double val) {
   if (error.isPositive("setZTHR",val)) {
-    if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-      error.addWarning("[setZTHR] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+    if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+      error.addWarning(ErrorLog::WRONG_DETECTOR,"setZTHR","Detector % is not an instance of WCV detector",detector_class);
     } else {
+      memo.clear();
       ((WCV_tvar*)detector)->setZTHR(val);
     }
     parameters.setZTHR(val);
@@ -846,9 +1083,10 @@ void Daidalus::setZTHR(double val) {
  */
 void Daidalus::setTTHR(double val) {
   if (error.isNonNegative("setTTHR",val)) {
-    if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-      error.addWarning("[setTTHR] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+    if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+      error.addWarning(ErrorLog::WRONG_DETECTOR,"setTTHR","Detector % is not an instance of WCV detector",detector_class);
     } else {
+      memo.clear();
       ((WCV_tvar*)detector)->setTTHR(val);
     }
     parameters.setTTHR(val);
@@ -860,9 +1098,10 @@ void Daidalus::setTTHR(double val) {
  */
 void Daidalus::setTCOA(double val) {
   if (error.isNonNegative("setTCOA",val)) {
-    if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar"))) {
-      error.addWarning("[setTCOA] Detector "+detector->getCanonicalClassName()+" is not an instance of WCV detector");
+    if (detector->getSuperClassTag() != Detection3DRegistry::TAG_WCV_TVAR) {
+      error.addWarning(ErrorLog::WRONG_DETECTOR,"setTCOA","Detector % is not an instance of WCV detector",detector_class);
     } else {
+      memo.clear();
       ((WCV_tvar*)detector)->setTCOA(val);
     }
     parameters.setTCOA(val);
@@ -874,9 +1113,10 @@ void Daidalus::setTCOA(double val) {
  */
 void Daidalus::setD(double val) {
   if (error.isPositive("setD",val)) {
-    if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.CDCylinder"))) {
-      error.addWarning("[setD] Detector "+detector->getCanonicalClassName()+" is not an instance of CD3D detector");
+    if (detector->getSuperClassTag() != Detection3DRegistry::TAG_CDCYLINDER) {
+      error.addWarning(ErrorLog::WRONG_DETECTOR,"setD","Detector % is not an instance of CD3D detector",detector_class);
     } else {
+      memo.clear();
       ((CDCylinder*)detector)->setHorizontalSeparation(val);
     }
     parameters.setD(val);
@@ -888,9 +1128,10 @@ void Daidalus::setD(double val) {
  */
 void Daidalus::setH(double val) {
   if (error.isPositive("setH",val)) {
-    if (!(equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.CDCylinder"))) {
-      error.addWarning("[setH] Detector "+detector->getCanonicalClassName()+" is not an instance of CD3D detector");
+    if (detector->getSuperClassTag() != Detection3DRegistry::TAG_CDCYLINDER) {
+      error.addWarning(ErrorLog::WRONG_DETECTOR,"setH","Detector % is not an instance of CD3D detector",detector_class);
     } else {
+      memo.clear();
       ((CDCylinder*)detector)->setVerticalSeparation(val);
     }
     parameters.setH(val);
@@ -2021,12 +2262,13 @@ void Daidalus::disableCollisionAvoidanceBands() {
 }
 
 void Daidalus::set_detector_from_parameters() {
-  if (equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.WCV_tvar")) {
+  memo.clear();
+  if (detector->getSuperClassTag() == Detection3DRegistry::TAG_WCV_TVAR) {
     ((WCV_tvar *)detector)->setDTHR(parameters.getDTHR());
     ((WCV_tvar *)detector)->setZTHR(parameters.getZTHR());
     ((WCV_tvar *)detector)->setTTHR(parameters.getTTHR());
     ((WCV_tvar *)detector)->setTCOA(parameters.getTCOA());
-  } else if (equals(detector->getCanonicalSuperClassName(),"gov.nasa.larcfm.ACCoRD.CDCylinder")) {
+  } else if (detector->getSuperClassTag() == Detection3DRegistry::TAG_CDCYLINDER) {
     ((CDCylinder *)detector)->setHorizontalSeparation(parameters.getD());
     ((CDCylinder *)detector)->setVerticalSeparation((parameters.getH()));
   }
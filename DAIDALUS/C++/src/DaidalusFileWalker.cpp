@@ -121,4 +121,18 @@ void DaidalusFileWalker::readState(Daidalus& daa) {
   goNext();
 }
 
+DaidalusJob DaidalusFileWalker::readJob() {
+  DaidalusJob job;
+  for (int ac = 0; ac < sr.size();++ac) {
+    TrafficState state(sr.getName(ac),sr.getPosition(ac),sr.getVelocity(ac));
+    if (ac==0) {
+      job = DaidalusJob(state,getTime());
+    } else {
+      job.addTraffic(state);
+    }
+  }
+  goNext();
+  return job;
+}
+
 }
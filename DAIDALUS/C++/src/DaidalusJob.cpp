@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "DaidalusJob.h"
+#include "TrafficState.h"
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+DaidalusJob::DaidalusJob() {
+  ownship = TrafficState::INVALID;
+  time = 0;
+}
+
+DaidalusJob::DaidalusJob(const TrafficState& own, double t) {
+  ownship = own;
+  time = t;
+}
+
+void DaidalusJob::addTraffic(const TrafficState& ac) {
+  traffic.push_back(ac);
+}
+
+std::string DaidalusJob::ownshipId() const {
+  return ownship.getId();
+}
+
+const TrafficState& DaidalusJob::getOwnship() const {
+  return ownship;
+}
+
+const std::vector<TrafficState>& DaidalusJob::getTraffic() const {
+  return traffic;
+}
+
+double DaidalusJob::getTime() const {
+  return time;
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "DaidalusResult.h"
+#include "KinematicBands.h"
+#include "TrafficState.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace larcfm {
+
+DaidalusResult::DaidalusResult() {
+  index = -1;
+  id = TrafficState::INVALID.getId();
+}
+
+DaidalusResult::DaidalusResult(int i, const std::string& name, const std::vector<int>& al, const KinematicBands& b) {
+  index = i;
+  id = name;
+  alerts = al;
+  bands = b;
+}
+
+DaidalusResult::DaidalusResult(int i, const std::string& name, const std::vector<int>& al, KinematicBands&& b) :
+    bands(std::move(b)) {
+  index = i;
+  id = name;
+  alerts = al;
+}
+
+int DaidalusResult::ownshipIndex() const {
+  return index;
+}
+
+std::string DaidalusResult::ownshipId() const {
+  return id;
+}
+
+int DaidalusResult::alerting(int ac) const {
+  if (ac < 0 || ac >= (int) alerts.size()) {
+    return -1;
+  }
+  return alerts[ac];
+}
+
+KinematicBands& DaidalusResult::getKinematicBands() {
+  return bands;
+}
+
+}
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "DaidalusService.h"
+#include "Daidalus.h"
+#include "DaidalusJob.h"
+#include "DaidalusResult.h"
+#include "KinematicBands.h"
+#include "format.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace larcfm {
+
+DaidalusJobStats::DaidalusJobStats() {
+  wait_time = 0;
+  compute_time = 0;
+  worker = -1;
+}
+
+DaidalusJobStats::DaidalusJobStats(double wt, double ct, int w) {
+  wait_time = wt;
+  compute_time = ct;
+  worker = w;
+}
+
+double DaidalusJobStats::waitTime() const {
+  return wait_time;
+}
+
+double DaidalusJobStats::computeTime() const {
+  return compute_time;
+}
+
+double DaidalusJobStats::latency() const {
+  return wait_time+compute_time;
+}
+
+int DaidalusJobStats::workerIndex() const {
+  return worker;
+}
+
+DaidalusService::Ownship::Ownship(const std::string& ownship, const Daidalus& dda) : id(ownship) {
+  daa = new Daidalus(dda);
+  scheduled = false;
+  removed = false;
+  home = 0;
+}
+
+DaidalusService::Ownship::~Ownship() {
+  delete daa;
+}
+
+DaidalusService::DaidalusService(const Daidalus& daa, int n, const Callback& cb) : prototype(daa), error("DaidalusService") {
+  callback = cb;
+  pending = 0;
+  next_home = 0;
+  stop = false;
+  jobs_done = 0;
+  max_latency = 0;
+  sum_latency = 0;
+  queues.resize(std::max(n,0));
+  for (int w = 0; w < n; ++w) {
+    workers.push_back(std::thread(&DaidalusService::worker,this,w));
+  }
+}
+
+DaidalusService::~DaidalusService() {
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  for (int w = 0; w < (int) workers.size(); ++w) {
+    workers[w].join();
+  }
+  for (std::map<std::string,Ownship*>::iterator it = ownships.begin(); it != ownships.end(); ++it) {
+    delete it->second;
+  }
+}
+
+void DaidalusService::submit(const DaidalusJob& job) {
+  std::unique_lock<std::mutex> lock(mutex);
+  Ownship*& own = ownships[job.ownshipId()];
+  if (own == NULL) {
+    own = new Ownship(job.ownshipId(),prototype);
+    if (!queues.empty()) {
+      own->home = next_home;
+      next_home = (next_home+1) % queues.size();
+    }
+  }
+  Pending p;
+  p.job = job;
+  p.submitted = Clock::now();
+  // The ownship was removed while it had pending jobs: this job starts with a new Daidalus object
+  p.reset = own->removed;
+  own->removed = false;
+  own->jobs.push_back(p);
+  ++pending;
+  if (own->scheduled) {
+    // The ownship is already queued, or its jobs are being processed
+    return;
+  }
+  own->scheduled = true;
+  if (!queues.empty()) {
+    queues[own->home].push_back(own);
+    lock.unlock();
+    cv.notify_one();
+    return;
+  }
+  // No workers: process the jobs of this ownship in the calling thread
+  while (!own->jobs.empty()) {
+    Pending q = own->jobs.front();
+    own->jobs.pop_front();
+    lock.unlock();
+    process(own,q,-1);
+    lock.lock();
+  }
+  release(own);
+}
+
+bool DaidalusService::removeOwnship(const std::string& id) {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::map<std::string,Ownship*>::iterator it = ownships.find(id);
+  if (it == ownships.end() || it->second->removed) {
+    return false;
+  }
+  it->second->removed = true;
+  if (!it->second->scheduled) {
+    release(it->second);
+  }
+  return true;
+}
+
+// The mutex is held by the caller, and the ownship has no pending jobs
+void DaidalusService::release(Ownship* own) {
+  own->scheduled = false;
+  if (own->removed) {
+    ownships.erase(own->id);
+    delete own;
+  }
+}
+
+// The mutex is held by the caller
+DaidalusService::Ownship* DaidalusService::take(int w) {
+  if (!queues[w].empty()) {
+    Ownship* own = queues[w].front();
+    queues[w].pop_front();
+    return own;
+  }
+  int n = queues.size();
+  for (int k = 1; k < n; ++k) {
+    std::deque<Ownship*>& q = queues[(w+k) % n];
+    if (!q.empty()) {
+      Ownship* own = q.back();
+      q.pop_back();
+      return own;
+    }
+  }
+  return NULL;
+}
+
+void DaidalusService::worker(int w) {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    Ownship* own = take(w);
+    if (own == NULL) {
+      if (stop) {
+        return;
+      }
+      cv.wait(lock);
+      continue;
+    }
+    Pending p = own->jobs.front();
+    own->jobs.pop_front();
+    lock.unlock();
+    process(own,p,w);
+    lock.lock();
+    if (own->jobs.empty()) {
+      release(own);
+    } else {
+      // Jobs submitted in the meantime are queued behind the other ownships of this worker
+      own->home = w;
+      queues[w].push_back(own);
+    }
+  }
+}
+
+void DaidalusService::process(Ownship* own, const Pending& p, int w) {
+  Clock::time_point start = Clock::now();
+  const DaidalusJob& job = p.job;
+  if (p.reset) {
+    std::lock_guard<std::mutex> lock(mutex);
+    delete own->daa;
+    own->daa = new Daidalus(prototype);
+  }
+  Daidalus& daa = *own->daa;
+  // Clears the aircraft of the previous job, and keeps the wind of the prototype
+  daa.setOwnshipState(job.getOwnship(),job.getTime());
+  const std::vector<TrafficState>& traffic = job.getTraffic();
+  for (int i = 0; i < (int) traffic.size(); ++i) {
+    daa.addTrafficState(traffic[i]);
+  }
+  std::vector<int> alerts(traffic.size()+1,-1);
+  for (int ac = 1; ac < (int) alerts.size(); ++ac) {
+    alerts[ac] = daa.alerting(ac);
+  }
+  KinematicBands bands = daa.getKinematicBands();
+  bands.computeAllBands();
+  DaidalusResult result(0,job.ownshipId(),alerts,std::move(bands));
+  Clock::time_point end = Clock::now();
+  if (daa.hasMessage()) {
+    bool err = daa.hasError();
+    std::string msg = daa.getMessage();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (err) {
+      error.addError(ErrorLog::UNSPECIFIED,"["+job.ownshipId()+"] "+msg);
+    } else {
+      error.addWarning(ErrorLog::UNSPECIFIED,"["+job.ownshipId()+"] "+msg);
+    }
+  }
+  DaidalusJobStats stats(std::chrono::duration<double>(start-p.submitted).count(),
+      std::chrono::duration<double>(end-start).count(),w);
+  try {
+    callback(job,result,stats);
+  } catch (const std::exception& e) {
+    failed(job,e.what());
+  } catch (...) {
+    failed(job,"unknown exception");
+  }
+  completed(stats.latency());
+}
+
+void DaidalusService::failed(const DaidalusJob& job, const std::string& what) {
+  std::lock_guard<std::mutex> lock(mutex);
+  error.addError(ErrorLog::UNSPECIFIED,"[callback] Job of "+job.ownshipId()+" at time "+FmPrecision(job.getTime())+
+      " threw "+what);
+}
+
+void DaidalusService::completed(double latency) {
+  std::lock_guard<std::mutex> lock(mutex);
+  ++jobs_done;
+  max_latency = std::max(max_latency,latency);
+  sum_latency += latency;
+  if (--pending == 0) {
+    idle.notify_all();
+  }
+}
+
+void DaidalusService::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (pending > 0) {
+    idle.wait(lock);
+  }
+}
+
+int DaidalusService::size() const {
+  return workers.size();
+}
+
+int DaidalusService::ownshipCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return ownships.size();
+}
+
+long DaidalusService::completedJobs() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return jobs_done;
+}
+
+double DaidalusService::maxLatency() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return max_latency;
+}
+
+double DaidalusService::averageLatency() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return jobs_done == 0 ? 0 : sum_latency/jobs_done;
+}
+
+bool DaidalusService::hasError() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return error.hasError();
+}
+
+bool DaidalusService::hasMessage() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return error.hasMessage();
+}
+
+std::string DaidalusService::getMessage() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return error.getMessage();
+}
+
+std::string DaidalusService::getMessageNoClear() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return error.getMessageNoClear();
+}
+
+}
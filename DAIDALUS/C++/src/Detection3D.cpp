@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2013-2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "Detection3D.h"
+#include "Detection3DRegistry.h"
+#include "Vect3.h"
+#include "Velocity.h"
+#include "TrafficArrays.h"
+#include "Util.h"
+#include <cmath>
+
+namespace larcfm {
+
+int Detection3D::getClassTag() const {
+  return Detection3DRegistry::tag(getCanonicalClassName());
+}
+
+int Detection3D::getSuperClassTag() const {
+  return Detection3DRegistry::tag(getCanonicalSuperClassName());
+}
+
+bool Detection3D::anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const {
+  for (int i = 0; i < traffic.size(); ++i) {
+    Velocity vi = traffic.v(i);
+    if (violation(so,vo,vi.ScalAdd(t,traffic.s(i)),vi)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Detection3D::anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const {
+  for (int i = 0; i < traffic.size(); ++i) {
+    Velocity vi = traffic.v(i);
+    if (conflict(so,vo,vi.ScalAdd(t,traffic.s(i)),vi,B,T)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Detection3D::reachable_block(char* keep, int i0, int n, const Vect3& so, const Velocity& vo, const TrafficArrays& traffic,
+    double t, double B, double T, double h0, double h1, double z0, double z1) {
+  if (!(0 <= B && B < T) || ISINF(T)) {
+    for (int j = 0; j < n; ++j) {
+      keep[j] = true;
+    }
+    return;
+  }
+  // Relative slack that absorbs rounding errors of the detectors
+  double eps = 1E-6;
+  double hT = h1+T;
+  double zT = z1+T;
+  const double* sx = traffic.sx.data()+i0;
+  const double* sy = traffic.sy.data()+i0;
+  const double* sz = traffic.sz.data()+i0;
+  const double* vx = traffic.vx.data()+i0;
+  const double* vy = traffic.vy.data()+i0;
+  const double* vz = traffic.vz.data()+i0;
+  // The distance at any time in [B,T] is at least the current distance minus T times the relative speed
+  for (int j = 0; j < n; ++j) {
+    double x = so.x-(t*vx[j]+sx[j]);
+    double y = so.y-(t*vy[j]+sy[j]);
+    double z = so.z-(t*vz[j]+sz[j]);
+    double wx = vo.x-vx[j];
+    double wy = vo.y-vy[j];
+    double wz = vo.z-vz[j];
+    double hb = h0+hT*std::sqrt(wx*wx+wy*wy);
+    double zb = z0+zT*std::abs(wz);
+    keep[j] = (std::sqrt(x*x+y*y) <= hb+eps*(1+hb)) & (std::abs(z) <= zb+eps*(1+zb));
+  }
+}
+
+}
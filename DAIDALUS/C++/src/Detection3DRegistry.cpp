@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "Detection3DRegistry.h"
+#include "Detection3D.h"
+#include "CDCylinder.h"
+#include "WCV_TAUMOD.h"
+#include "WCV_TCPA.h"
+#include "TCAS3D.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+const int Detection3DRegistry::UNKNOWN;
+const int Detection3DRegistry::TAG_CDCYLINDER;
+const int Detection3DRegistry::TAG_WCV_TVAR;
+const int Detection3DRegistry::TAG_WCV_TAUMOD;
+const int Detection3DRegistry::TAG_WCV_TCPA;
+const int Detection3DRegistry::TAG_TCAS3D;
+
+namespace {
+
+const std::string PACKAGE = "gov.nasa.larcfm.ACCoRD.";
+
+class Registry {
+public:
+  std::mutex mutex;
+  std::map<std::string,int> tags;                  // Tags indexed by canonical class name
+  std::map<std::string,Detection3D*> prototypes;   // Prototypes indexed by canonical class name
+
+  Registry() {
+    tags[PACKAGE+"CDCylinder"] = Detection3DRegistry::TAG_CDCYLINDER;
+    tags[PACKAGE+"WCV_tvar"] = Detection3DRegistry::TAG_WCV_TVAR;
+    tags[PACKAGE+"WCV_TAUMOD"] = Detection3DRegistry::TAG_WCV_TAUMOD;
+    tags[PACKAGE+"WCV_TCPA"] = Detection3DRegistry::TAG_WCV_TCPA;
+    tags[PACKAGE+"TCAS3D"] = Detection3DRegistry::TAG_TCAS3D;
+    prototypes[PACKAGE+"CDCylinder"] = new CDCylinder();
+    prototypes[PACKAGE+"WCV_TAUMOD"] = new WCV_TAUMOD();
+    prototypes[PACKAGE+"WCV_TCPA"] = new WCV_TCPA();
+    prototypes[PACKAGE+"TCAS3D"] = new TCAS3D();
+  }
+
+  ~Registry() {
+    std::map<std::string,Detection3D*>::iterator it;
+    for (it = prototypes.begin(); it != prototypes.end(); ++it) {
+      delete it->second;
+    }
+  }
+
+  // Assumes that mutex is locked
+  int add_tag(const std::string& name) {
+    std::map<std::string,int>::const_iterator it = tags.find(name);
+    if (it != tags.end()) {
+      return it->second;
+    }
+    int t = tags.size();
+    tags[name] = t;
+    return t;
+  }
+};
+
+Registry& registry() {
+  static Registry reg;
+  return reg;
+}
+
+std::string canonical(const std::string& classname) {
+  return classname.find('.') == std::string::npos ? PACKAGE+classname : classname;
+}
+
+}
+
+int Detection3DRegistry::registerDetector(const Detection3D& det) {
+  std::string name = det.getCanonicalClassName();
+  Detection3D* prototype = det.copy();
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.add_tag(det.getCanonicalSuperClassName());
+  std::map<std::string,Detection3D*>::iterator it = reg.prototypes.find(name);
+  if (it != reg.prototypes.end()) {
+    delete it->second;
+    it->second = prototype;
+  } else {
+    reg.prototypes[name] = prototype;
+  }
+  return reg.add_tag(name);
+}
+
+int Detection3DRegistry::tag(const std::string& classname) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::map<std::string,int>::const_iterator it = reg.tags.find(canonical(classname));
+  return it == reg.tags.end() ? UNKNOWN : it->second;
+}
+
+bool Detection3DRegistry::isRegistered(const std::string& classname) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  return reg.prototypes.find(canonical(classname)) != reg.prototypes.end();
+}
+
+Detection3D* Detection3DRegistry::make(const std::string& classname) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::map<std::string,Detection3D*>::const_iterator it = reg.prototypes.find(canonical(classname));
+  return it == reg.prototypes.end() ? NULL : it->second->copy();
+}
+
+std::vector<std::string> Detection3DRegistry::classNames() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::vector<std::string> names;
+  std::map<std::string,Detection3D*>::const_iterator it;
+  for (it = reg.prototypes.begin(); it != reg.prototypes.end(); ++it) {
+    names.push_back(it->first);
+  }
+  return names;
+}
+
+}
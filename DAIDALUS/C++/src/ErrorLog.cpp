@@ -13,22 +13,25 @@
 #include <iostream>
 #include "format.h"
 #include <cstdlib>
+#include <algorithm>
 
 namespace larcfm {
 
   using namespace std;
 	
-  int ErrorLog::global_purge_flag = 0;
-  int ErrorLog::limit = 25;
+  atomic<int> ErrorLog::global_purge_flag(0);
+  atomic<int> ErrorLog::limit(25);
 
   ErrorLog::ErrorLog(const string& name) {
     this->name = string(name);
-    message = "";
+    first = 0;
+    count = 0;
+    capacity = 0;
+    dropped = false;
     has_error = false;
     fail_fast = false;
     console_out = false;
     local_purge_flag = global_purge_flag;
-    size = 0;
   }
   
   void ErrorLog::setFailFast(bool ff) {
@@ -38,57 +41,154 @@ namespace larcfm {
   void ErrorLog::setConsoleOutput(bool console) {
     console_out = console;
   }
-	
-  void ErrorLog::addError(const string& msg) {
-	    if (local_purge_flag != global_purge_flag) {
-			message = "";
-	    	local_purge_flag = global_purge_flag;
-	    }
-	    //fpln(" $$$$ ErrorLog: addError: "+msg);
-    has_error = true;
-    message += "ERROR in ";
-    message += name;
-    message += ": ";
-    message += msg;
-    message += "\n";
-    if (fail_fast) {
-      cout << message;
+
+  ErrorLog::Entry& ErrorLog::next(bool error, Code code) {
+    int flag = global_purge_flag.load(memory_order_relaxed);
+    if (local_purge_flag != flag) {
+      first = 0;
+      count = 0;
+      dropped = false;
+      has_error = false;
+      local_purge_flag = flag;
+    }
+    int lim = std::max(1,limit.load(memory_order_relaxed));
+    Entry* e;
+    if (count == lim) {
+      // Overwrite the oldest message, which becomes the newest one
+      e = &entries[first];
+      first = (first+1) % capacity;
+      dropped = true;
+    } else {
+      // The limit may have changed since the log was filled up
+      std::rotate(entries.begin(),entries.begin()+first,entries.begin()+count);
+      first = 0;
+      if (count > lim) {
+        entries.erase(entries.begin(),entries.begin()+(count-lim+1));
+        count = lim-1;
+        dropped = true;
+      }
+      if (count == (int) entries.size()) {
+        entries.push_back(Entry());
+      }
+      e = &entries[count++];
+      capacity = lim;
+    }
+    e->error = error;
+    e->code = code;
+    e->where = NULL;
+    e->text = NULL;
+    e->sarg = false;
+    e->nargs = 0;
+    e->precision = 0;
+    if (error) {
+      has_error = true;
+    }
+    return *e;
+  }
+
+  void ErrorLog::added(const Entry& e) {
+    if (fail_fast && e.error) {
+      cout << getMessageNoClear();
       exit(1);
     }
     if (console_out) {
-      cout << "ERROR in " << name << ": " << msg << endl;
+      cout << (e.error ? "ERROR in " : "Warning in ") << name << ": " << format(e) << endl;
     }
-	size++;
-	if (size > limit) {
-		int idx = message.find("\n");
-		message.erase(0, idx);
-		message.insert(0,"[...] ");
-		size--;
-	}
+  }
 
+  void ErrorLog::add(bool error, Code code, const char* where, const char* text, int precision, int nargs, double a, double b) {
+    Entry& e = next(error,code);
+    e.where = where;
+    e.text = text;
+    e.precision = precision;
+    e.nargs = nargs;
+    e.args[0] = a;
+    e.args[1] = b;
+    added(e);
   }
-	
-  void ErrorLog::addWarning(const string& msg) {
-    if (local_purge_flag != global_purge_flag) {
-		message = "";
-		has_error = false;
-    	local_purge_flag = global_purge_flag;
+
+  string ErrorLog::format(const Entry& e) const {
+    if (e.text == NULL) {
+      return e.str;
     }
-    message += "Warning in ";
-    message += name;
-    message += ": ";
-    message += msg;
-    message += "\n";
-    if (console_out) {
-      cout << "Warning in " << name << ": " << msg << endl;
+    string s = "";
+    if (e.where != NULL) {
+      s += "[";
+      s += e.where;
+      s += "] ";
+    }
+    int k = 0;
+    bool sarg = e.sarg;
+    for (const char* p = e.text; *p != '\0'; ++p) {
+      if (*p == '%' && sarg) {
+        s += e.str;
+        sarg = false;
+      } else if (*p == '%' && k < e.nargs) {
+        s += e.precision == 0 ? Fm0(e.args[k]) : FmPrecision(e.args[k],e.precision);
+        ++k;
+      } else {
+        s += *p;
+      }
     }
-	size++;
-	if (size > limit) {
-		int idx = message.find("\n");
-		message.erase(0, idx);
-		message.insert(0,"[...] ");
-		size--;
-	}
+    return s;
+  }
+	
+  void ErrorLog::addError(const string& msg) {
+    addError(UNSPECIFIED,msg);
+  }
+	
+  void ErrorLog::addWarning(const string& msg) {
+    addWarning(UNSPECIFIED,msg);
+  }
+
+  void ErrorLog::addError(Code code, const string& msg) {
+    Entry& e = next(true,code);
+    e.str = msg;
+    added(e);
+  }
+
+  void ErrorLog::addWarning(Code code, const string& msg) {
+    Entry& e = next(false,code);
+    e.str = msg;
+    added(e);
+  }
+
+  void ErrorLog::addError(Code code, const char* text) {
+    add(true,code,NULL,text,0,0,0,0);
+  }
+
+  void ErrorLog::addError(Code code, const char* text, double a) {
+    add(true,code,NULL,text,0,1,a,0);
+  }
+
+  void ErrorLog::addError(Code code, const char* text, double a, double b) {
+    add(true,code,NULL,text,0,2,a,b);
+  }
+
+  void ErrorLog::addWarning(Code code, const char* text) {
+    add(false,code,NULL,text,0,0,0,0);
+  }
+
+  void ErrorLog::addWarning(Code code, const char* text, double a) {
+    add(false,code,NULL,text,0,1,a,0);
+  }
+
+  void ErrorLog::addError(Code code, const char* where, const char* text, const string& arg) {
+    Entry& e = next(true,code);
+    e.where = where;
+    e.text = text;
+    e.str = arg;
+    e.sarg = true;
+    added(e);
+  }
+
+  void ErrorLog::addWarning(Code code, const char* where, const char* text, const string& arg) {
+    Entry& e = next(false,code);
+    e.where = where;
+    e.text = text;
+    e.str = arg;
+    e.sarg = true;
+    added(e);
   }
 
   void ErrorLog::addReporter(ErrorReporter& reporter) {
@@ -104,22 +204,36 @@ namespace larcfm {
   }
 	  
   void ErrorLog::purge() {
-	  global_purge_flag = (global_purge_flag + 1) % 10000;
+    int flag = global_purge_flag.load();
+    while (!global_purge_flag.compare_exchange_weak(flag,(flag + 1) % 10000)) {
+    }
   }
 
   void ErrorLog::setSizeLimit(int sz) {
 	  limit = sz;
   }
 	
+  bool ErrorLog::isPositive(const char* method, double val) {
+    if (val > 0) return true;
+    add(true,INVALID_VALUE,method,"Value % is non positive",4,1,val,0);
+    return false;
+  }
+
+  bool ErrorLog::isNonNegative(const char* method, double val) {
+    if (val >= 0) return true;
+    add(true,INVALID_VALUE,method,"Value % is negative",4,1,val,0);
+    return false;
+  }
+
   bool ErrorLog::isPositive(const std::string& method, double val) {
     if (val > 0) return true;
-    addError("["+method+"] Value "+Fm4(val)+" is non positive");
+    addError(INVALID_VALUE,"["+method+"] Value "+Fm4(val)+" is non positive");
     return false;
   }
 
   bool ErrorLog::isNonNegative(const std::string& method, double val) {
     if (val >= 0) return true;
-    addError("["+method+"] Value "+Fm4(val)+" is negative");
+    addError(INVALID_VALUE,"["+method+"] Value "+Fm4(val)+" is negative");
     return false;
   }
 
@@ -131,19 +245,49 @@ namespace larcfm {
   }
 	
   bool ErrorLog::hasMessage() const {
-    return message.length() > 0;
+    return count > 0;
   }
 	
   string ErrorLog::getMessage() {
     has_error = false;
     string rtn = getMessageNoClear();
-    message = "";
-    size = 0;
+    first = 0;
+    count = 0;
+    dropped = false;
     return rtn;
   }
 	
   string ErrorLog::getMessageNoClear() const {
-    return message;
+    string s = dropped ? "[...] \n" : "";
+    for (int i = 0; i < count; ++i) {
+      const Entry& e = entry(i);
+      s += e.error ? "ERROR in " : "Warning in ";
+      s += name;
+      s += ": ";
+      s += format(e);
+      s += "\n";
+    }
+    return s;
+  }
+
+  int ErrorLog::messageCount() const {
+    return count;
+  }
+
+  const ErrorLog::Entry& ErrorLog::entry(int i) const {
+    return entries[(first+i) % capacity];
+  }
+
+  bool ErrorLog::isError(int i) const {
+    return 0 <= i && i < count && entry(i).error;
+  }
+
+  ErrorLog::Code ErrorLog::getCode(int i) const {
+    return 0 <= i && i < count ? entry(i).code : UNSPECIFIED;
+  }
+
+  string ErrorLog::getText(int i) const {
+    return 0 <= i && i < count ? format(entry(i)) : "";
   }
 
 }
@@ -15,9 +15,9 @@
 #include "format.h"
 #include "ErrorLog.h"
 #include <iostream>
-#include <cstdlib>
-#include <cstring>
 #include <vector>
+#include <algorithm>
+#include <utility>
 
 using namespace std;
 using namespace larcfm;
@@ -25,30 +25,107 @@ using namespace larcfm;
 const Interval IntervalSet::empty = Interval();
 
 IntervalSet::IntervalSet() {//: error("IntervalSet") {
+	r = buf;
 	length = 0;
+	capacity = inline_intervals;
 }
 
 IntervalSet::IntervalSet(const IntervalSet& l) {//: error("IntervalSet") {
+	r = buf;
+	length = 0;
+	capacity = inline_intervals;
+	reserve(l.length);
+	std::copy(l.r,l.r+l.length,r);
 	length = l.length;
+}
 
-	memcpy(r,l.r,sizeof(Interval)*length);
-	//for (int i = 0; i < length; i++) {
-	//  r[i] = Interval(l.r[i]);  // deep copy
-	//}
+IntervalSet::IntervalSet(IntervalSet&& l) {
+	r = buf;
+	length = 0;
+	capacity = inline_intervals;
+	take(l);
 }
 
 IntervalSet::IntervalSet(const std::vector<Interval>& v) {//: error("IntervalSet") {
+	r = buf;
+	length = 0;
+	capacity = inline_intervals;
+	reserve(v.size());
+	std::copy(v.begin(),v.end(),r);
 	length = v.size();
-	memcpy(r,&v[0],sizeof(Interval)*length);
 }
 
-std::vector<Interval> IntervalSet::toVector() const {
-	std::vector<Interval> v = std::vector<Interval>();
-	v.reserve(length);
-	for (int i = 0; i < length; i++) {
-		v.push_back(v[i]);
+IntervalSet::~IntervalSet() {
+	if (r != buf) {
+		delete[] r;
+	}
+}
+
+IntervalSet& IntervalSet::operator=(const IntervalSet& l) {
+	if (this != &l) {
+		length = 0;
+		reserve(l.length);
+		std::copy(l.r,l.r+l.length,r);
+		length = l.length;
+	}
+	return *this;
+}
+
+IntervalSet& IntervalSet::operator=(IntervalSet&& l) {
+	if (this != &l) {
+		if (r != buf) {
+			delete[] r;
+		}
+		r = buf;
+		length = 0;
+		capacity = inline_intervals;
+		take(l);
+	}
+	return *this;
+}
+
+void IntervalSet::swap(IntervalSet& l) {
+	IntervalSet t(std::move(l));
+	l = std::move(*this);
+	*this = std::move(t);
+}
+
+/*
+ * Take the contents of l, which is left empty. This set is assumed to be empty
+ * and to use its inline buffer.
+ */
+void IntervalSet::take(IntervalSet& l) {
+	if (l.r != l.buf) {
+		r = l.r;
+		capacity = l.capacity;
+	} else {
+		std::copy(l.buf,l.buf+l.length,buf);
+	}
+	length = l.length;
+	l.r = l.buf;
+	l.length = 0;
+	l.capacity = inline_intervals;
+}
+
+/*
+ * Ensure there is room for at least n intervals.
+ */
+void IntervalSet::reserve(int n) {
+	if (n <= capacity) {
+		return;
+	}
+	int c = std::max(n,2*capacity);
+	Interval* nr = new Interval[c];
+	std::copy(r,r+length,nr);
+	if (r != buf) {
+		delete[] r;
 	}
-	return v;
+	r = nr;
+	capacity = c;
+}
+
+std::vector<Interval> IntervalSet::toVector() const {
+	return std::vector<Interval>(r,r+length);
 }
 
 void IntervalSet::clear() {
@@ -119,27 +196,28 @@ void IntervalSet::unions(const IntervalSet& n) {
  * This method uses "almost" inequalities to compute the addition.
  */
 void IntervalSet::almost_add(double l, double u) {
-	IntervalSet m = IntervalSet(*this);
-	clear();
-	bool go = false;
-	for (int i=0; i < m.size(); ++i) {
-		Interval ii = m.getInterval(i);
-		if (go) {
-			unions(ii);
-		} else if ((Util::almost_leq(ii.low,l,PRECISION_DEFAULT) && Util::almost_leq(l,ii.up,PRECISION_DEFAULT)) ||
-				(Util::almost_leq(l,ii.low,PRECISION_DEFAULT) && Util::almost_leq(ii.low,u,PRECISION_DEFAULT))) {
-			l = std::min(ii.low,l);
-			u = std::max(ii.up,u);
-		} else if (Util::almost_less(u,ii.low,PRECISION_DEFAULT)) {
-			unions(Interval(l,u));
-			unions(ii);
-			go = true;
-		} else {
-			unions(ii);
-		}
+	// Skip the intervals that are strictly below [l,u]
+	int i = 0;
+	while (i < length &&
+			!(Util::almost_leq(r[i].low,l,PRECISION_DEFAULT) && Util::almost_leq(l,r[i].up,PRECISION_DEFAULT)) &&
+			!(Util::almost_leq(l,r[i].low,PRECISION_DEFAULT) && Util::almost_leq(r[i].low,u,PRECISION_DEFAULT)) &&
+			!Util::almost_less(u,r[i].low,PRECISION_DEFAULT)) {
+		++i;
+	}
+	// Merge the intervals that overlap [l,u]
+	int start = i;
+	while (i < length &&
+			((Util::almost_leq(r[i].low,l,PRECISION_DEFAULT) && Util::almost_leq(l,r[i].up,PRECISION_DEFAULT)) ||
+					(Util::almost_leq(l,r[i].low,PRECISION_DEFAULT) && Util::almost_leq(r[i].low,u,PRECISION_DEFAULT)))) {
+		l = std::min(r[i].low,l);
+		u = std::max(r[i].up,u);
+		++i;
 	}
-	if (!go) {
-		unions(Interval(l,u));
+	if (i > start) {
+		r[start] = Interval(l,u);
+		remove(start+1,i-start-1);
+	} else {
+		insert(start,Interval(l,u));
 	}
 }
 
@@ -148,8 +226,8 @@ void IntervalSet::almost_add(double l, double u) {
  * unmodified. This method uses "almost" inequalities to compute the intersection.
  */
 void IntervalSet::almost_intersect(const IntervalSet& n) {
-	IntervalSet m = IntervalSet(*this);
-	clear();
+	IntervalSet m;
+	m.swap(*this);
 	if (!m.isEmpty() && !n.isEmpty()) {
 		int i=0;
 		int j=0;
@@ -159,19 +237,19 @@ void IntervalSet::almost_intersect(const IntervalSet& n) {
 			if (Util::almost_leq(jj.low,ii.low,PRECISION_DEFAULT) &&
 					Util::almost_less(ii.low,jj.up,PRECISION_DEFAULT)) {
 				if (Util::almost_leq(ii.up,jj.up,PRECISION_DEFAULT)) {
-					unions(ii);
+					append(ii);
 					++i;
 				} else {
-					unions(Interval(ii.low,jj.up));
+					append(Interval(ii.low,jj.up));
 					++j;
 				}
 			} else if (Util::almost_leq(ii.low,jj.low,PRECISION_DEFAULT) &&
 					Util::almost_less(jj.low,ii.up,PRECISION_DEFAULT)) {
 				if (Util::almost_leq(jj.up,ii.up,PRECISION_DEFAULT)) {
-					unions(jj);
+					append(jj);
 					++j;
 				} else {
-					unions(Interval(jj.low,ii.up));
+					append(Interval(jj.low,ii.up));
 					++i;
 				}
 			} else if (Util::almost_leq(ii.up,jj.low,PRECISION_DEFAULT)){
@@ -284,55 +362,43 @@ void IntervalSet::insert(int i, const Interval& region) {
 		i = length;
 	}
 
-	if (i == length && length < max_intervals) {
-		r[length] = region;
-		length++;
-	} else {
-		length++;
-		int c = length;
-
-		if (length >= max_intervals) {
-			std::cout << "ERROR: IntervalSet is full, fixing this requires a recompile" << endl;
-			exit(1);
-		}
-
-		while (i < c) {
-			r[c] = r[c-1];
-			c--;
-		}
+	reserve(length+1);
+	std::copy_backward(r+i,r+length,r+length+1);
+	r[i] = region;
+	length++;
+} // insert
 
-		r[i] = region;
+/*
+ * Add the given interval at the end of the list. It is merged with the
+ * last interval if they overlap.
+ */
+void IntervalSet::append(const Interval& rn) {
+	if (length > 0 && rn.low <= r[length-1].up) {
+		unions(rn);
+	} else {
+		insert(length,rn);
 	}
-} // insert
+}
 
 /* 
- * Remove Interval i and return it
+ * Remove Interval i
  */
 void IntervalSet::remove(int i) {
-	if (i < 0 || i >= length ) {
-		return;
-		//return Interval();
-	}
-
-	Interval t = r[i];
-
-	while (i + 1 < length) {
-		r[i] = r[i+1];
-		i++;
-	}
-
-	length--;
-
-	//return t;
+	remove(i,1);
 }
 
 /* 
  * Remove the len number of intervals starting at i.
  */
 void IntervalSet::remove(int i, int len) {
-	for( int j = 0; j < len; j++) {
-		remove(i);
+	if (i < 0 || i >= length || len <= 0) {
+		return;
+	}
+	if (len > length-i) {
+		len = length-i;
 	}
+	std::copy(r+i+len,r+length,r+i);
+	length -= len;
 }
 
 /* 
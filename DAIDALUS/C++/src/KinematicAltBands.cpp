@@ -22,16 +22,19 @@
 
 namespace larcfm {
 
-KinematicAltBands::KinematicAltBands() {
+KinematicAltBands::KinematicAltBands() : KinematicAltBands(*DefaultDaidalusParameters::getSnapshot()) {
+}
+
+KinematicAltBands::KinematicAltBands(const DaidalusParameters& parameters) {
   intervals = std::vector<Interval>();
   regions = std::vector<BandsRegion::Region>();
   recovery_time = 0;
-  min = DefaultDaidalusParameters::getMinAltitude();
-  max = DefaultDaidalusParameters::getMaxAltitude();
-  step = DefaultDaidalusParameters::getAltitudeStep();
+  min = parameters.getMinAltitude();
+  max = parameters.getMaxAltitude();
+  step = parameters.getAltitudeStep();
   do_recovery = false;
-  vertical_rate = DefaultDaidalusParameters::getVerticalRate();
-  vertical_accel = DefaultDaidalusParameters::getVerticalAcceleration();
+  vertical_rate = parameters.getVerticalRate();
+  vertical_accel = parameters.getVerticalAcceleration();
 }
 
 KinematicAltBands::KinematicAltBands(const KinematicAltBands& b) {
@@ -100,14 +103,14 @@ ConflictData KinematicAltBands::checkConflict(Detection3D* detector, const Ownsh
   return detector->conflictDetection(ownship.pos_to_s(po),ownship.vel_to_v(po,vo),ownship.pos_to_s(pi),ownship.vel_to_v(pi,vi), B,T);
 }
 
+void KinematicAltBands::resetTraffic(const std::string& id) {
+  reset();
+}
+
 void KinematicAltBands::compute(KinematicBandsCore& core) {
-  std::vector<TrafficState> traffic;
-  for (int i = 0; i < core.trafficSize(); ++i) {
-    traffic.push_back(core.getTraffic(i));
-  }
   IntervalSet redset;
-  if (!traffic.empty()) {
-    red_bands(redset,core.detector,0,core.alertingTime(),core.ownship,traffic);
+  if (!core.traffic.empty()) {
+    red_bands(redset,core.detector,0,core.alertingTime(),core.ownship,core.traffic);
   }
   color_bands(redset,false,core.implicit_bands,false);
 }
@@ -128,7 +131,7 @@ void KinematicAltBands::red_bands(IntervalSet& redset, Detection3D* detector, do
       //f.pln("boundedAltitude: can't make time "+in);
     } else if (svt.third < T){
       for (int i=0; i < traffic.size(); ++i) {
-        TrafficState ac = traffic[i];
+        const TrafficState& ac = traffic[i];
         Position pi = ac.getPosition().linear(ac.getVelocity(), svt.third);
         Velocity vi = ac.getVelocity();
         if (checkConflict(detector, ownship,svt.first,svt.second,pi,vi,std::max(0.0,B-svt.third),std::max(1.0,T-svt.third)).conflict()) {
@@ -167,7 +170,7 @@ IntervalSet KinematicAltBands::losSetDuringFL(Detection3D* detector, double tste
       double dt = std::min(ProjectedKinematics::vsLevelOutTime(ownship.getPosition(), ownship.getVelocity(), vertical_rate, fl1, vertical_accel), T);
       //f.pln(Units.to("ft", fl1)+" dt="+dt);
       for (int i=0; i < traffic.size(); ++i) {
-        TrafficState ac = traffic[i];
+        const TrafficState& ac = traffic[i];
         Velocity vi = ac.getVelocity();
         if (!goUp || fl1 > max || conflictSet.in(fl1)) { // shortcut
           losSet.unions(Interval(fl1-step, fl1+step));
@@ -198,7 +201,7 @@ IntervalSet KinematicAltBands::losSetDuringFL(Detection3D* detector, double tste
     if (fl2 < ownship.getPosition().z()) {
       double dt = std::min(ProjectedKinematics::vsLevelOutTime(ownship.getPosition(), ownship.getVelocity(), vertical_rate, fl2, vertical_accel),T);
       for (int i=0; i < traffic.size(); ++i) {
-        TrafficState ac = traffic[i];
+        const TrafficState& ac = traffic[i];
         Velocity vi = ac.getVelocity();
         if (!goDown || fl2 < min || conflictSet.in(fl2)) { // shortcut
           losSet.unions(Interval(fl2-step, fl2+step));
@@ -26,12 +26,7 @@ namespace larcfm {
  * is specified by the parameters.
  * @param detector        State detector
  */
-KinematicBands::KinematicBands(const Detection3D* det) : error("KinematicBands") {
-  core = KinematicBandsCore(det);
-  trk_band = KinematicTrkBands();
-  gs_band = KinematicGsBands();
-  vs_band = KinematicVsBands();
-  alt_band = KinematicAltBands();
+KinematicBands::KinematicBands(const Detection3D* det) : core(det), error("KinematicBands") {
   trk_band.setRecovery(false);
   gs_band.setRecovery(false);
   vs_band.setRecovery(false);
@@ -42,16 +37,20 @@ KinematicBands::KinematicBands(const Detection3D* det) : error("KinematicBands")
  * configuration parameters. The default state detector is cylinder.
  */
 KinematicBands::KinematicBands() : error("KinematicBands") {
-  core = KinematicBandsCore();
-  trk_band = KinematicTrkBands();
-  gs_band = KinematicGsBands();
-  vs_band = KinematicVsBands();
-  alt_band = KinematicAltBands();
   trk_band.setRecovery(false);
   gs_band.setRecovery(false);
   vs_band.setRecovery(false);
 }
 
+/**
+ * Construct a KinematicBands object with the given detector and parameters. This is the same as
+ * constructing it with the detector and calling setParameters, without reading the default parameters.
+ */
+KinematicBands::KinematicBands(const Detection3D* det, const DaidalusParameters& parameters) :
+    trk_band(parameters), gs_band(parameters), vs_band(parameters), alt_band(parameters),
+    core(det,parameters), error("KinematicBands") {
+}
+
 /**
  * Construct a KinematicBands object from an existing KinematicBands object. This copies all traffic data.
  */
@@ -61,6 +60,7 @@ KinematicBands::KinematicBands(const KinematicBands& b) : error("KinematicBands"
   gs_band = KinematicGsBands(b.gs_band);
   vs_band = KinematicVsBands(b.vs_band);
   alt_band = KinematicAltBands(b.alt_band);
+  setThreadPool(b.getThreadPool());
 }
 
 /** Ownship and Traffic **/
@@ -108,12 +108,12 @@ bool KinematicBands::hasTraffic() const {
 
 void KinematicBands::addTraffic(const TrafficState& ac) {
   if (!hasOwnship()) {
-    error.addError("addTraffic: setOwnship must be called before addTraffic.");
+    error.addError(ErrorLog::NO_DATA,"addTraffic: setOwnship must be called before addTraffic.");
   } else if (ac.isLatLon() != isLatLon()) {
-    error.addError("addTraffic: inconsistent use of lat/lon and Euclidean data.");
+    error.addError(ErrorLog::INCONSISTENT_DATA,"addTraffic: inconsistent use of lat/lon and Euclidean data.");
   } else {
     core.traffic.push_back(ac);
-    reset();
+    resetTraffic(ac.getId());
   }
 }
 
@@ -125,6 +125,41 @@ void KinematicBands::addTraffic(const Position& pi, const Velocity& vi) {
   addTraffic("AC_"+Fm0i(core.traffic.size()+1),pi,vi);
 }
 
+void KinematicBands::updateTraffic(const TrafficState& ac) {
+  if (!hasOwnship()) {
+    error.addError(ErrorLog::NO_DATA,"updateTraffic: setOwnship must be called before updateTraffic.");
+  } else if (ac.isLatLon() != isLatLon()) {
+    error.addError(ErrorLog::INCONSISTENT_DATA,"updateTraffic: inconsistent use of lat/lon and Euclidean data.");
+  } else {
+    for (int i = 0; i < (int) core.traffic.size(); ++i) {
+      if (core.traffic[i].getId() == ac.getId()) {
+        core.traffic[i] = ac;
+        resetTraffic(ac.getId());
+        return;
+      }
+    }
+    addTraffic(ac);
+  }
+}
+
+void KinematicBands::removeTraffic(const std::string& id) {
+  std::vector<TrafficState>::iterator it = core.traffic.begin();
+  bool found = false;
+  while (it != core.traffic.end()) {
+    if (it->getId() == id) {
+      it = core.traffic.erase(it);
+      found = true;
+    } else {
+      ++it;
+    }
+  }
+  if (found) {
+    resetTraffic(id);
+  } else {
+    error.addWarning(ErrorLog::NOT_FOUND,"removeTraffic: aircraft "+id+" not found.");
+  }
+}
+
 /** General Settings **/
 
 void KinematicBands::setParameters(const DaidalusParameters& parameters) {
@@ -1034,8 +1069,53 @@ void KinematicBands::reset() {
   alt_band.reset();
 }
 
+void KinematicBands::resetTraffic(const std::string& id) {
+  // Bands of all aircraft depend on the state of the criteria aircraft
+  if (id == core.criteria_ac) {
+    reset();
+  } else {
+    trk_band.resetTraffic(id);
+    gs_band.resetTraffic(id);
+    vs_band.resetTraffic(id);
+    alt_band.resetTraffic(id);
+  }
+}
+
 /** Main interface methods **/
 
+void KinematicBands::setThreadPool(ThreadPool* pool) {
+  trk_band.setThreadPool(pool);
+  gs_band.setThreadPool(pool);
+  vs_band.setThreadPool(pool);
+  alt_band.setThreadPool(pool);
+}
+
+ThreadPool* KinematicBands::getThreadPool() const {
+  return trk_band.getThreadPool();
+}
+
+void KinematicBands::computeAllBands() {
+  ThreadPool* pool = getThreadPool();
+  if (pool == NULL) {
+    trk_band.recompute(core);
+    gs_band.recompute(core);
+    vs_band.recompute(core);
+    alt_band.recompute(core);
+    return;
+  }
+  // Each dimension only reads core and writes its own band object
+  std::vector<std::function<void()> > tasks;
+  tasks.push_back([this]() { trk_band.recompute(core); });
+  tasks.push_back([this]() { gs_band.recompute(core); });
+  tasks.push_back([this]() { vs_band.recompute(core); });
+  tasks.push_back([this]() { alt_band.recompute(core); });
+  pool->run(tasks);
+}
+
+int KinematicBands::prunedTrafficCount() const {
+  return trk_band.prunedTrafficCount()+gs_band.prunedTrafficCount()+vs_band.prunedTrafficCount();
+}
+
 /**
  * @return the number of track band intervals, negative if the ownship has not been KinematicBands::set
  */
@@ -1043,6 +1123,14 @@ int KinematicBands::trackLength() {
   return trk_band.bandsLength(core);
 }
 
+const std::vector<Interval>& KinematicBands::trackIntervals() {
+  return trk_band.getIntervals(core);
+}
+
+const std::vector<BandsRegion::Region>& KinematicBands::trackRegions() {
+  return trk_band.getRegions(core);
+}
+
 /**
  * Force computation of track bands. Usually, bands are only computed when needed. This method
  * forces the computation of track bands (this method is included mainly for debugging purposes).
@@ -1116,6 +1204,14 @@ int KinematicBands::groundSpeedLength() {
   return gs_band.bandsLength(core);
 }
 
+const std::vector<Interval>& KinematicBands::groundSpeedIntervals() {
+  return gs_band.getIntervals(core);
+}
+
+const std::vector<BandsRegion::Region>& KinematicBands::groundSpeedRegions() {
+  return gs_band.getRegions(core);
+}
+
 /**
  * Force computation of ground speed bands. Usually, bands are only computed when needed. This method
  * forces the computation of ground speed bands (this method is included mainly for debugging purposes).
@@ -1189,6 +1285,14 @@ int KinematicBands::verticalSpeedLength() {
   return vs_band.bandsLength(core);
 }
 
+const std::vector<Interval>& KinematicBands::verticalSpeedIntervals() {
+  return vs_band.getIntervals(core);
+}
+
+const std::vector<BandsRegion::Region>& KinematicBands::verticalSpeedRegions() {
+  return vs_band.getRegions(core);
+}
+
 /**
  * Force computation of vertical speed bands. Usually, bands are only computed when needed. This method
  * forces the computation of vertical speed bands (this method is included mainly for debugging purposes).
@@ -1262,6 +1366,14 @@ int KinematicBands::altitudeLength() {
   return alt_band.bandsLength(core);
 }
 
+const std::vector<Interval>& KinematicBands::altitudeIntervals() {
+  return alt_band.getIntervals(core);
+}
+
+const std::vector<BandsRegion::Region>& KinematicBands::altitudeRegions() {
+  return alt_band.getRegions(core);
+}
+
 /**
  * Force computation of altitude bands. Usually, bands are only computed when needed. This method
  * forces the computation of altitude bands (this method is included mainly for debugging purposes).
@@ -16,43 +16,41 @@
 #include <string>
 #include <vector>
 #include "DefaultDaidalusParameters.h"
+#include <utility>
 
 namespace larcfm {
 
-TCASTable KinematicBandsCore::RA = TCASTable();
+const TCASTable KinematicBandsCore::RA = TCASTable();
 
 KinematicBandsCore::KinematicBandsCore() {
-  ownship = OwnshipState::INVALID;
-  traffic = std::vector<TrafficState>();
-  implicit_bands = DefaultDaidalusParameters::isEnabledImplicitBands();
-  lookahead = DefaultDaidalusParameters::getLookaheadTime();
-  alerting_time = DefaultDaidalusParameters::getAlertingTime();
-  max_recovery_time = DefaultDaidalusParameters::getMaxRecoveryTime();
-  recovery_stability_time = DefaultDaidalusParameters::getRecoveryStabilityTime();
-  criteria_ac = TrafficState::INVALID.getId();
-  conflict_crit = DefaultDaidalusParameters::isEnabledConflictCriteria();
-  recovery_crit = DefaultDaidalusParameters::isEnabledRecoveryCriteria();
-  min_horizontal_recovery = DefaultDaidalusParameters::getMinHorizontalRecovery();
-  min_vertical_recovery = DefaultDaidalusParameters::getMinVerticalRecovery();
-  ca_bands = DefaultDaidalusParameters::isEnabledCollisionAvoidanceBands();
+  init(*DefaultDaidalusParameters::getSnapshot());
   detector = new CDCylinder();
 }
 
 KinematicBandsCore::KinematicBandsCore(const Detection3D* det) {
+  init(*DefaultDaidalusParameters::getSnapshot());
+  detector = det->copy();
+}
+
+KinematicBandsCore::KinematicBandsCore(const Detection3D* det, const DaidalusParameters& parameters) {
+  init(parameters);
+  detector = det->copy();
+}
+
+void KinematicBandsCore::init(const DaidalusParameters& parameters) {
   ownship = OwnshipState::INVALID;
   traffic = std::vector<TrafficState>();
-  implicit_bands = DefaultDaidalusParameters::isEnabledImplicitBands();
-  lookahead = DefaultDaidalusParameters::getLookaheadTime();
-  alerting_time = DefaultDaidalusParameters::getAlertingTime();
-  max_recovery_time = DefaultDaidalusParameters::getMaxRecoveryTime();
-  recovery_stability_time = DefaultDaidalusParameters::getRecoveryStabilityTime();
+  implicit_bands = parameters.isEnabledImplicitBands();
+  lookahead = parameters.getLookaheadTime();
+  alerting_time = parameters.getAlertingTime();
+  max_recovery_time = parameters.getMaxRecoveryTime();
+  recovery_stability_time = parameters.getRecoveryStabilityTime();
   criteria_ac = TrafficState::INVALID.getId();
-  conflict_crit = DefaultDaidalusParameters::isEnabledConflictCriteria();
-  recovery_crit = DefaultDaidalusParameters::isEnabledRecoveryCriteria();
-  min_horizontal_recovery = DefaultDaidalusParameters::getMinHorizontalRecovery();
-  min_vertical_recovery = DefaultDaidalusParameters::getMinVerticalRecovery();
-  ca_bands = DefaultDaidalusParameters::isEnabledCollisionAvoidanceBands();
-  detector = det->copy();
+  conflict_crit = parameters.isEnabledConflictCriteria();
+  recovery_crit = parameters.isEnabledRecoveryCriteria();
+  min_horizontal_recovery = parameters.getMinHorizontalRecovery();
+  min_vertical_recovery = parameters.getMinVerticalRecovery();
+  ca_bands = parameters.isEnabledCollisionAvoidanceBands();
 }
 
 KinematicBandsCore::KinematicBandsCore(const KinematicBandsCore& core) {
@@ -75,12 +73,32 @@ KinematicBandsCore::KinematicBandsCore(const KinematicBandsCore& core) {
   detector = core.detector->copy();
 }
 
+KinematicBandsCore::KinematicBandsCore(KinematicBandsCore&& core) : ownship(core.ownship), traffic(std::move(core.traffic)) {
+  implicit_bands = core.implicit_bands;
+  lookahead = core.lookahead;
+  alerting_time = core.alerting_time;
+  max_recovery_time = core.max_recovery_time;
+  recovery_stability_time = core.recovery_stability_time;
+  criteria_ac = core.criteria_ac;
+  conflict_crit = core.conflict_crit;
+  recovery_crit = core.recovery_crit;
+  min_horizontal_recovery = core.min_horizontal_recovery;
+  min_vertical_recovery = core.min_vertical_recovery;
+  ca_bands = core.ca_bands;
+  detector = core.detector;
+  core.detector = NULL;
+}
+
 KinematicBandsCore::~KinematicBandsCore() {
   delete detector;
 }
 
 KinematicBandsCore& KinematicBandsCore::operator=(const KinematicBandsCore& core) {
+  if (this == &core) {
+    return *this;
+  }
   ownship = OwnshipState(core.ownship);
+  traffic.clear();
   for (int i = 0; i < (int) core.traffic.size(); ++i) {
     TrafficState ac = core.traffic[i];
     traffic.push_back(TrafficState(ac));
@@ -96,10 +114,32 @@ KinematicBandsCore& KinematicBandsCore::operator=(const KinematicBandsCore& core
   min_horizontal_recovery = core.min_horizontal_recovery;
   min_vertical_recovery = core.min_vertical_recovery;
   ca_bands = core.ca_bands;
+  delete detector;
   detector = core.detector->copy();
   return *this;
 }
 
+KinematicBandsCore& KinematicBandsCore::operator=(KinematicBandsCore&& core) {
+  if (this == &core) {
+    return *this;
+  }
+  ownship = core.ownship;
+  traffic = std::move(core.traffic);
+  implicit_bands = core.implicit_bands;
+  lookahead = core.lookahead;
+  alerting_time = core.alerting_time;
+  max_recovery_time = core.max_recovery_time;
+  recovery_stability_time = core.recovery_stability_time;
+  criteria_ac = core.criteria_ac;
+  conflict_crit = core.conflict_crit;
+  recovery_crit = core.recovery_crit;
+  min_horizontal_recovery = core.min_horizontal_recovery;
+  min_vertical_recovery = core.min_vertical_recovery;
+  ca_bands = core.ca_bands;
+  std::swap(detector,core.detector);
+  return *this;
+}
+
 
 /**
  *  Clear ownship and traffic data from this object.
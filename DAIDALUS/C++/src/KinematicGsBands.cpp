@@ -5,6 +5,7 @@
  * Rights Reserved.
  */
 #include "KinematicGsBands.h"
+#include "CriticalVectors.h"
 #include "Vect3.h"
 #include "Velocity.h"
 #include "Position.h"
@@ -15,21 +16,25 @@
 #include "BandsRegion.h"
 #include "Integerval.h"
 #include "ProjectedKinematics.h"
+#include "Kinematics.h"
 #include <cmath>
 #include "DefaultDaidalusParameters.h"
 
 
 namespace larcfm {
 
-KinematicGsBands::KinematicGsBands() {
+KinematicGsBands::KinematicGsBands() : KinematicGsBands(*DefaultDaidalusParameters::getSnapshot()) {
+}
+
+KinematicGsBands::KinematicGsBands(const DaidalusParameters& parameters) {
   intervals = std::vector<Interval>();
   regions = std::vector<BandsRegion::Region>();
   recovery_time = 0;
-  min = DefaultDaidalusParameters::getMinGroundSpeed();
-  max = DefaultDaidalusParameters::getMaxGroundSpeed();
-  step = DefaultDaidalusParameters::getGroundSpeedStep();
-  do_recovery = DefaultDaidalusParameters::isEnabledRecoveryGroundSpeedBands();
-  horizontal_accel = DefaultDaidalusParameters::getHorizontalAcceleration();
+  min = parameters.getMinGroundSpeed();
+  max = parameters.getMaxGroundSpeed();
+  step = parameters.getGroundSpeedStep();
+  do_recovery = parameters.isEnabledRecoveryGroundSpeedBands();
+  horizontal_accel = parameters.getHorizontalAcceleration();
 }
 
 KinematicGsBands::KinematicGsBands(const KinematicGsBands& b) {
@@ -55,6 +60,13 @@ double KinematicGsBands::getHorizontalAcceleration() const {
 }
 
 std::pair<Vect3, Velocity> KinematicGsBands::trajectory(const OwnshipState& ownship, double time, bool dir) const {
+  if (!ownship.isLatLon()) {
+    // Euclidean ownship: the projected state is the state itself
+    Velocity vo = ownship.get_v();
+    double a = (dir?1:-1)*horizontal_accel;
+    return std::pair<Vect3, Velocity>(Kinematics::gsAccelPos(ownship.get_s(),vo,time,a),
+        Velocity::mkTrkGsVs(vo.trk(),vo.gs()+a*time,vo.vs()));
+  }
   std::pair<Position,Velocity> posvel = ProjectedKinematics::gsAccel(ownship.getPosition(),ownship.getVelocity(),time,
       (dir?1:-1)*horizontal_accel);
   return std::pair<Vect3, Velocity>(ownship.pos_to_s(posvel.first),ownship.vel_to_v(posvel.first,posvel.second));
@@ -62,6 +74,9 @@ std::pair<Vect3, Velocity> KinematicGsBands::trajectory(const OwnshipState& owns
 
 bool KinematicGsBands::any_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
     double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    return instantaneous_any_red(conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  }
   double gso = ownship.getVelocity().gs();
   int maxdown = (int)std::max(std::ceil((gso-min)/step),0.0)+1;
   int maxup = (int)std::max(std::ceil((max-gso)/step),0.0)+1;
@@ -75,6 +90,9 @@ bool KinematicGsBands::any_red(Detection3D* conflict_det, Detection3D* recovery_
 
 bool KinematicGsBands::all_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
     double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    return instantaneous_all_red(conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  }
   double gso = ownship.getVelocity().gs();
   int maxdown = (int)std::max(std::ceil((gso-min)/step),0.0)+1;
   int maxup = (int)std::max(std::ceil((max-gso)/step),0.0)+1;
@@ -88,11 +106,26 @@ bool KinematicGsBands::all_red(Detection3D* conflict_det, Detection3D* recovery_
 
 void KinematicGsBands::none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac, double B, double T,
     const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    if (!instantaneous_none_bands(noneset,conflict_det,recovery_det,repac,B,T,ownship,traffic)) {
+      double gso = ownship.getVelocity().gs();
+      int maxdown = (int)std::max(std::ceil((gso-min)/step),0.0)+1;
+      int maxup = (int)std::max(std::ceil((max-gso)/step),0.0)+1;
+      std::vector<Integerval>& gsint = int_bands;
+      int epsh = 0;
+      if (repac.isValid()) {
+        epsh = KinematicBandsCore::epsilonH(ownship,repac);
+      }
+      instantaneous_bands_combine(gsint,conflict_det,recovery_det,B,T,step,maxdown,maxup,ownship,traffic,repac,epsh,0);
+      KinematicIntegerBands::toIntervalSet(noneset,gsint,step,gso,min,max);
+    }
+    return;
+  }
   double gso = ownship.getVelocity().gs();
   int maxdown = (int)std::max(std::ceil((gso-min)/step),0.0)+1;
   int maxup = (int)std::max(std::ceil((max-gso)/step),0.0)+1;
   double tstep = step/horizontal_accel;
-  std::vector<Integerval> gsint = std::vector<Integerval>();
+  std::vector<Integerval>& gsint = int_bands;
   int epsh = 0;
   if (repac.isValid()) {
     epsh = KinematicBandsCore::epsilonH(ownship,repac);
@@ -101,5 +134,46 @@ void KinematicGsBands::none_bands(IntervalSet& noneset, Detection3D* conflict_de
   KinematicIntegerBands::toIntervalSet(noneset,gsint,step,gso,min,max);
 }
 
+bool KinematicGsBands::exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const {
+  if (instantaneous_bands()) {
+    return KinematicRealBands::exists_green(conflict_det,recovery_det,repac,B,T,ownship,traffic,cache);
+  }
+  double gso = ownship.getVelocity().gs();
+  int maxdown = (int)std::max(std::ceil((gso-min)/step),0.0)+1;
+  int maxup = (int)std::max(std::ceil((max-gso)/step),0.0)+1;
+  double tstep = step/horizontal_accel;
+  int epsh = 0;
+  if (repac.isValid()) {
+    epsh = KinematicBandsCore::epsilonH(ownship,repac);
+  }
+  return any_int_green(conflict_det,recovery_det,tstep,B,T,0,B,maxdown,maxup,ownship,traffic,repac,epsh,0,
+      step,gso,min,max,cache);
+}
+
+double KinematicGsBands::max_ownship_gs(const OwnshipState& ownship) const {
+  // Kinematic maneuvers may overshoot max by the last steps of the search
+  return std::max(ownship.get_v().gs(),max)+2*step;
+}
+
+bool KinematicGsBands::instantaneous_bands() const {
+  return horizontal_accel == 0;
+}
+
+double KinematicGsBands::instantaneous_value(const Velocity& v) const {
+  return v.gs();
 }
 
+Velocity KinematicGsBands::instantaneous_velocity(const Velocity& v, double val) const {
+  return v.mkGs(val);
+}
+
+void KinematicGsBands::critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+    double D, double H, double B, double T) const {
+  std::list<Vect2> gss = CriticalVectors::groundSpeeds(s,vo,vi,D,H,B,T);
+  for (std::list<Vect2>::const_iterator it = gss.begin(); it != gss.end(); ++it) {
+    vals.push_back(it->norm());
+  }
+}
+
+}
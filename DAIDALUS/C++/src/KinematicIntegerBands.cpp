@@ -12,6 +12,7 @@
 #include "CriteriaCore.h"
 #include "TrafficState.h"
 #include "OwnshipState.h"
+#include "TrafficArrays.h"
 #include "Integerval.h"
 #include "IntervalSet.h"
 #include "TCASTable.h"
@@ -21,10 +22,64 @@
 
 namespace larcfm {
 
+KinematicIntegerBands::KinematicIntegerBands() {
+  thread_pool = NULL;
+  traj_tstep[0] = traj_tstep[1] = 0;
+}
+
+void KinematicIntegerBands::LosCache::clear() {
+  for (int i = 0; i < 2; ++i) {
+    los[i][0].clear();
+    los[i][1].clear();
+  }
+}
+
+void KinematicIntegerBands::setThreadPool(ThreadPool* pool) {
+  thread_pool = pool;
+}
+
+ThreadPool* KinematicIntegerBands::getThreadPool() const {
+  return thread_pool;
+}
+
+void KinematicIntegerBands::clear_trajectory_cache(bool trajdir) const {
+  int d = trajdir ? 1 : 0;
+  traj_cache[d].clear();
+  traj_known[d].clear();
+}
+
+void KinematicIntegerBands::clear_trajectory_cache() const {
+  clear_trajectory_cache(false);
+  clear_trajectory_cache(true);
+}
+
+void KinematicIntegerBands::prepare_trajectory_cache(const OwnshipState& ownship, double tstep, bool trajdir) const {
+  int d = trajdir ? 1 : 0;
+  if (tstep != traj_tstep[d] || !(ownship.getPosition() == traj_pos[d]) || !(ownship.getVelocity() == traj_vel[d])) {
+    clear_trajectory_cache(trajdir);
+    traj_pos[d] = ownship.getPosition();
+    traj_vel[d] = ownship.getVelocity();
+    traj_tstep[d] = tstep;
+  }
+}
+
+std::pair<Vect3,Velocity> KinematicIntegerBands::trajectory_step(const OwnshipState& ownship, double tstep, bool trajdir, int k) const {
+  int d = trajdir ? 1 : 0;
+  if (k >= (int) traj_cache[d].size()) {
+    traj_cache[d].resize(k+1,std::pair<Vect3,Velocity>(Vect3::INVALID(),Velocity::INVALIDV()));
+    traj_known[d].resize(k+1,false);
+  }
+  if (!traj_known[d][k]) {
+    traj_cache[d][k] = trajectory(ownship,k*tstep,trajdir);
+    traj_known[d][k] = true;
+  }
+  return traj_cache[d][k];
+}
+
 int KinematicIntegerBands::first_los_step(Detection3D* det, double tstep,bool trajdir,
-    int min, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+    int min, int max, const OwnshipState& ownship, const TrafficArrays& traffic) const {
   for (int k=min; k<=max; ++k) {
-    if (any_los_aircraft(det,trajdir,k*tstep,ownship,traffic)) {
+    if (any_los_aircraft(det,trajdir,tstep,k,ownship,traffic)) {
       return k;
     }
   }
@@ -33,7 +88,7 @@ int KinematicIntegerBands::first_los_step(Detection3D* det, double tstep,bool tr
 
 int KinematicIntegerBands::first_los_search_index(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
     double B, double T, double B2, double T2, bool trajdir, int max,
-    const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+    const OwnshipState& ownship, const TrafficArrays& traffic) const {
   int FirstLosK = (int)std::ceil(B/tstep); // first k such that k*ts>=B
   int FirstLosN = std::min((int)std::floor(T/tstep),max); // last k<=MaxN such that k*ts<=T
   int FirstLosK2 = (int)std::ceil(B2/tstep);
@@ -47,7 +102,7 @@ int KinematicIntegerBands::first_los_search_index(Detection3D* conflict_det, Det
 
 int KinematicIntegerBands::bands_search_index(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
     double B, double T, double B2, double T2,
-    bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
+    bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
     int epsh, int epsv) const {
   bool usehcrit = repac.isValid() && epsh != 0;
   bool usevcrit = repac.isValid() && epsv != 0;
@@ -63,27 +118,31 @@ int KinematicIntegerBands::bands_search_index(Detection3D* conflict_det, Detecti
 }
 
 bool KinematicIntegerBands::any_conflict(Detection3D* conflict_det, Detection3D* recovery_det, double B, double T, double B2, double T2,
-    bool trajdir, double tsk, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+    bool trajdir, double tstep, int k, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  prepare_trajectory_cache(ownship,tstep,trajdir);
+  traffic_arrays.set(ownship,traffic);
+  return any_conflict(conflict_det,recovery_det,B,T,B2,T2,trajdir,tstep,k,ownship,traffic_arrays);
+}
+
+bool KinematicIntegerBands::any_conflict(Detection3D* conflict_det, Detection3D* recovery_det, double B, double T, double B2, double T2,
+    bool trajdir, double tstep, int k, const OwnshipState& ownship, const TrafficArrays& traffic) const {
   return
-      any_conflict_aircraft(conflict_det,B,T,trajdir,tsk,ownship,traffic) ||
+      any_conflict_aircraft(conflict_det,B,T,trajdir,tstep,k,ownship,traffic) ||
       (recovery_det != NULL &&
-          any_conflict_aircraft(recovery_det,B2,T2,trajdir,tsk,ownship,traffic));
+          any_conflict_aircraft(recovery_det,B2,T2,trajdir,tstep,k,ownship,traffic));
 }
 
 void KinematicIntegerBands::traj_conflict_only_bands(std::vector<Integerval>& l,
     Detection3D* conflict_det, Detection3D* recovery_det, double tstep, double B, double T, double B2, double T2,
-    bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+    bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic) const {
   int first = -1;
   for (int k = 0; k <= max; ++k) {
-    double tsk = tstep*k;
-    if (first >=0 && !any_conflict(conflict_det,recovery_det,B,T,B2,T2,trajdir,tsk,ownship,traffic)) {
+    if (first >=0 && !any_conflict(conflict_det,recovery_det,B,T,B2,T2,trajdir,tstep,k,ownship,traffic)) {
       continue;
     } else if (first >=0) {
-      std::vector<Integerval> nl = std::vector<Integerval>();
-      nl.push_back(Integerval(first,k-1));
+      l.push_back(Integerval(first,k-1));
       first = -1;
-      l.insert(l.end(),nl.begin(),nl.end());
-    } else if (!any_conflict(conflict_det,recovery_det,B,T,B2,T2,trajdir,tsk,ownship,traffic)) {
+    } else if (!any_conflict(conflict_det,recovery_det,B,T,B2,T2,trajdir,tstep,k,ownship,traffic)) {
       first = k;
     }
   }
@@ -94,9 +153,10 @@ void KinematicIntegerBands::traj_conflict_only_bands(std::vector<Integerval>& l,
 
 void KinematicIntegerBands::kinematic_bands(std::vector<Integerval>& l, Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
     double B, double T, double B2, double T2,
-    bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
+    bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
     int epsh, int epsv) const {
   l.clear();
+  prepare_trajectory_cache(ownship,tstep,trajdir);
   int bsi = bands_search_index(conflict_det,recovery_det,tstep,B,T,B2,T2,trajdir,max,ownship,traffic,repac,epsh,epsv);
   if  (bsi != 0) {
     traj_conflict_only_bands(l,conflict_det,recovery_det,tstep,B,T,B2,T2,trajdir,bsi-1,ownship,traffic);
@@ -106,11 +166,12 @@ void KinematicIntegerBands::kinematic_bands(std::vector<Integerval>& l, Detectio
 void KinematicIntegerBands::append_intband(std::vector<Integerval>& l, std::vector<Integerval>& r) {
   // Append in place
   int last = l.size()-1;
+  int first = 0;
   if (!l.empty() && !r.empty() && r[0].lb-l[last].ub <= 1) {
     l[last].ub = r[0].ub;
-    r.erase(r.begin());
+    first = 1;
   }
-  l.insert(l.end(),r.begin(),r.end());
+  l.insert(l.end(),r.begin()+first,r.end());
 }
 
 void KinematicIntegerBands::neg(std::vector<Integerval>& l) {
@@ -186,48 +247,88 @@ void KinematicIntegerBands::kinematic_bands_combine(std::vector<Integerval>& l,
     double B, double T, double B2, double T2,
     int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
     int epsh, int epsv) const {
-  kinematic_bands(l,conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic,repac,epsh,epsv);
-  std::vector<Integerval> r = std::vector<Integerval>();
-  kinematic_bands(r,conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic,repac,epsh,epsv);
+  std::vector<Integerval>& r = right_bands;
+  traffic_arrays.set(ownship,traffic);
+  if (thread_pool != NULL) {
+    // Left and right sweeps only share read-only data and use separate trajectory caches
+    std::vector<std::function<void()> > sweeps;
+    sweeps.push_back([&]() {
+      kinematic_bands(l,conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic_arrays,repac,epsh,epsv);
+    });
+    sweeps.push_back([&]() {
+      kinematic_bands(r,conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic_arrays,repac,epsh,epsv);
+    });
+    thread_pool->run(sweeps);
+  } else {
+    kinematic_bands(l,conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic_arrays,repac,epsh,epsv);
+    kinematic_bands(r,conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic_arrays,repac,epsh,epsv);
+  }
   neg(l);
   append_intband(l,r);
 }
 
-bool KinematicIntegerBands::any_los_aircraft(Detection3D* det, bool trajdir, double tsk,
-    const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
-  for (int i=0; i < traffic.size(); ++i) {
-    TrafficState ac = traffic[i];
-    std::pair<Vect3,Velocity> sovot = trajectory(ownship,tsk,trajdir);
-    Vect3 sot = sovot.first;
-    Velocity vot = sovot.second;
-    Vect3 si = ownship.traffic_s(ac);
-    Velocity vi = ownship.traffic_v(ac);
-    Vect3 sit = vi.ScalAdd(tsk,si);
-    if (det->violation(sot, vot, sit, vi))
-      return true;
+bool KinematicIntegerBands::any_los_aircraft(Detection3D* det, bool trajdir, double tstep, int k,
+    const OwnshipState& ownship, const TrafficArrays& traffic) const {
+  if (traffic.isEmpty()) {
+    return false;
   }
-  return false;
+  std::pair<Vect3,Velocity> sovot = trajectory_step(ownship,tstep,trajdir,k);
+  return det->anyViolation(sovot.first,sovot.second,traffic,tstep*k);
+}
+
+bool KinematicIntegerBands::los_at(Detection3D* det, int slot, LosCache* cache, bool trajdir, double tstep, int k,
+    const OwnshipState& ownship, const TrafficArrays& traffic) const {
+  if (cache == NULL) {
+    return any_los_aircraft(det,trajdir,tstep,k,ownship,traffic);
+  }
+  std::vector<char>& los = cache->los[slot][trajdir ? 1 : 0];
+  if (k >= (int) los.size()) {
+    los.resize(k+1,0);
+  }
+  if (los[k] == 0) {
+    los[k] = any_los_aircraft(det,trajdir,tstep,k,ownship,traffic) ? 1 : 2;
+  }
+  return los[k] == 1;
 }
 
 // trajdir: false is left
 int KinematicIntegerBands::first_green(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
     double B, double T, double B2, double T2,
-    bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
-    int epsh, int epsv) const {
+    bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
+    int epsh, int epsv, double scal, double add, double minval, double maxval, LosCache* cache) const {
   bool usehcrit = repac.isValid() && epsh != 0;
   bool usevcrit = repac.isValid() && epsv != 0;
+  // Same search windows as first_los_search_index
+  int FirstLosK = (int)std::ceil(B/tstep);
+  int FirstLosN = std::min((int)std::floor(T/tstep),max);
+  int FirstLosK2 = (int)std::ceil(B2/tstep);
+  int FirstLosN2 = std::min((int)std::floor(T2/tstep),max);
+  double sign = trajdir ? 1 : -1;
+  int first = -1; // First step of current green band
+  prepare_trajectory_cache(ownship,tstep,trajdir);
   for (int k=0; k <= max; ++k) {
-    double tsk = tstep*k;
-    if ((tsk >= B && tsk <= T && any_los_aircraft(conflict_det,trajdir,tsk,ownship,traffic)) ||
-        (recovery_det != NULL && tsk >= B2 && tsk <= T2 &&
-            any_los_aircraft(recovery_det,trajdir,tsk,ownship,traffic)) ||
+    if ((FirstLosK <= k && k <= FirstLosN && los_at(conflict_det,0,cache,trajdir,tstep,k,ownship,traffic)) ||
+        (recovery_det != NULL && FirstLosK2 <= k && k <= FirstLosN2 &&
+            los_at(recovery_det,1,cache,trajdir,tstep,k,ownship,traffic)) ||
             (usehcrit && !repulsive_at(tstep,trajdir,k,ownship,repac,epsh)) ||
             (usevcrit && !vert_repul_at(tstep,trajdir,k,ownship,repac,epsv))) {
       return -1;
-    } else if (!any_conflict_aircraft(conflict_det,B,T,trajdir,tsk,ownship,traffic) &&
-        !(recovery_det != NULL &&
-            any_conflict_aircraft(recovery_det,B2,T2,trajdir,tsk,ownship,traffic)))
-      return k;
+    } else if (!any_conflict(conflict_det,recovery_det,B,T,B2,T2,trajdir,tstep,k,ownship,traffic)) {
+      if (first < 0) {
+        first = k;
+      }
+      double vfirst = scal*sign*first+add;
+      double vk = scal*sign*k+add;
+      if (trajdir ? vfirst > maxval : vfirst < minval) {
+        // Values only move away from [minval,maxval] in this direction
+        return -1;
+      }
+      if (trajdir ? vk >= minval : vk <= maxval) {
+        return k;
+      }
+    } else {
+      first = -1;
+    }
   }
   return -1;
 }
@@ -237,14 +338,29 @@ bool KinematicIntegerBands::all_int_red(Detection3D* conflict_det, Detection3D*
     double B, double T, double B2, double T2,
     int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
     int epsh, int epsv, int dir) const {
-  bool leftans = dir > 0 || first_green(conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic,repac,epsh,epsv) < 0;
-  bool rightans = dir < 0 || first_green(conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic,repac,epsh,epsv) < 0;
+  traffic_arrays.set(ownship,traffic);
+  bool leftans = dir > 0 || first_green(conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic_arrays,repac,epsh,epsv,
+      0,0,NINFINITY,PINFINITY,NULL) < 0;
+  bool rightans = dir < 0 || first_green(conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic_arrays,repac,epsh,epsv,
+      0,0,NINFINITY,PINFINITY,NULL) < 0;
   return leftans && rightans;
 }
 
+// INTERFACE FUNCTION
+bool KinematicIntegerBands::any_int_green(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
+    double B, double T, double B2, double T2,
+    int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
+    int epsh, int epsv, double scal, double add, double minval, double maxval, LosCache* cache) const {
+  traffic_arrays.set(ownship,traffic);
+  return first_green(conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic_arrays,repac,epsh,epsv,
+      scal,add,minval,maxval,cache) >= 0 ||
+      first_green(conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic_arrays,repac,epsh,epsv,
+          scal,add,minval,maxval,cache) >= 0;
+}
+
 Vect3 KinematicIntegerBands::linvel(const OwnshipState& ownship, double tstep, bool trajdir, int k) const {
-  Vect3 s1 = trajectory(ownship,(k+1)*tstep,trajdir).first;
-  Vect3 s0 = trajectory(ownship,k*tstep,trajdir).first;
+  Vect3 s1 = trajectory_step(ownship,tstep,trajdir,k+1).first;
+  Vect3 s0 = trajectory_step(ownship,tstep,trajdir,k).first;
   return s1.Sub(s0).Scal(1/tstep);
 }
 
@@ -253,7 +369,7 @@ bool KinematicIntegerBands::repulsive_at(double tstep, bool trajdir, int k, cons
   if (k==0) {
     return true;
   }
-  std::pair<Vect3,Velocity> sovo = trajectory(ownship,0,trajdir);
+  std::pair<Vect3,Velocity> sovo = trajectory_step(ownship,tstep,trajdir,0);
   Vect3 so = sovo.first;
   Vect3 vo = sovo.second;
   Vect3 si = ownship.traffic_s(repac);
@@ -263,7 +379,7 @@ bool KinematicIntegerBands::repulsive_at(double tstep, bool trajdir, int k, cons
     rep = CriteriaCore::horizontal_new_repulsive_criterion(so.Sub(si),vo,vi,linvel(ownship,tstep,trajdir,0),epsh);
   }
   if (rep) {
-    std::pair<Vect3,Velocity> sovot = trajectory(ownship,k*tstep,trajdir);
+    std::pair<Vect3,Velocity> sovot = trajectory_step(ownship,tstep,trajdir,k);
     Vect3 sot = sovot.first;
     Vect3 vot = sovot.second;
     Vect3 sit = vi.ScalAdd(k*tstep,si);
@@ -293,7 +409,7 @@ bool KinematicIntegerBands::vert_repul_at(double tstep, bool trajdir, int k, con
   if (k==0) {
     return true;
   }
-  std::pair<Vect3,Velocity> sovo = trajectory(ownship,0,trajdir);
+  std::pair<Vect3,Velocity> sovo = trajectory_step(ownship,tstep,trajdir,0);
   Vect3 so = sovo.first;
   Vect3 vo = sovo.second;
   Vect3 si = ownship.traffic_s(repac);
@@ -303,7 +419,7 @@ bool KinematicIntegerBands::vert_repul_at(double tstep, bool trajdir, int k, con
     rep = CriteriaCore::vertical_new_repulsive_criterion(so.Sub(si),vo,vi,linvel(ownship,tstep,trajdir,0),epsv);
   }
   if (rep) {
-    std::pair<Vect3,Velocity> sovot = trajectory(ownship,k*tstep,trajdir);
+    std::pair<Vect3,Velocity> sovot = trajectory_step(ownship,tstep,trajdir,k);
     Vect3 sot = sovot.first;
     Vect3 vot = sovot.second;
     Vect3 sit = vi.ScalAdd(k*tstep,si);
@@ -327,33 +443,18 @@ int KinematicIntegerBands::first_nonvert_repul_step(double tstep, bool trajdir,
   return -1;
 }
 
-bool KinematicIntegerBands::cd_future_traj(Detection3D* det, double B, double T, bool trajdir, double t,
-    const OwnshipState& ownship, const TrafficState& ac) const {
-  if (t > T || B > T) return false;
-  std::pair<Vect3,Velocity> sovot = trajectory(ownship,t,trajdir);
-  Vect3 sot = sovot.first;
-  Velocity vot = sovot.second;
-  Vect3 si = ownship.traffic_s(ac);
-  Velocity vi = ownship.traffic_v(ac);
-  Vect3 sit = vi.ScalAdd(t,si);
-  if (B > t) return det->conflict(sot, vot, sit, vi, B-t, T-t);
-  return det->conflict(sot, vot, sit, vi, 0, T-t);
-}
-
-bool KinematicIntegerBands::any_conflict_aircraft(Detection3D* det, double B, double T, bool trajdir, double tsk,
-    const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
-  for (int i=0; i < traffic.size(); ++i) {
-    TrafficState ac = traffic[i];
-    if (cd_future_traj(det, B, T, trajdir, tsk, ownship, ac))
-      return true;
-  }
-  return false;
+bool KinematicIntegerBands::any_conflict_aircraft(Detection3D* det, double B, double T, bool trajdir, double tstep, int k,
+    const OwnshipState& ownship, const TrafficArrays& traffic) const {
+  double t = tstep*k;
+  if (traffic.isEmpty() || t > T || B > T) return false;
+  std::pair<Vect3,Velocity> sovot = trajectory_step(ownship,tstep,trajdir,k);
+  return det->anyConflict(sovot.first,sovot.second,traffic,t,B > t ? B-t : 0,T-t);
 }
 
 bool KinematicIntegerBands::any_conflict_step(Detection3D* det, double tstep, double B, double T, bool trajdir, int max,
-    const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+    const OwnshipState& ownship, const TrafficArrays& traffic) const {
   for (int k=0; k <= max; ++k) {
-    if (any_conflict_aircraft(det,B,T,trajdir,tstep*k,ownship,traffic)) {
+    if (any_conflict_aircraft(det,B,T,trajdir,tstep,k,ownship,traffic)) {
       return true;
     }
   }
@@ -365,8 +466,17 @@ bool KinematicIntegerBands::red_band_exist(Detection3D* conflict_det, Detection3
     double B, double T, double B2, double T2,
     bool trajdir, int max, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
     int epsh, int epsv) const {
+  traffic_arrays.set(ownship,traffic);
+  return red_band_exist(conflict_det,recovery_det,tstep,B,T,B2,T2,trajdir,max,ownship,traffic_arrays,repac,epsh,epsv);
+}
+
+bool KinematicIntegerBands::red_band_exist(Detection3D* conflict_det, Detection3D* recovery_det, double tstep,
+    double B, double T, double B2, double T2,
+    bool trajdir, int max, const OwnshipState& ownship, const TrafficArrays& traffic, const TrafficState& repac,
+    int epsh, int epsv) const {
   bool usehcrit = repac.isValid() && epsh != 0;
   bool usevcrit = repac.isValid() && epsv != 0;
+  prepare_trajectory_cache(ownship,tstep,trajdir);
   return (usehcrit && first_nonrepulsive_step(tstep,trajdir,max,ownship,repac,epsh) >= 0) ||
       (usevcrit && first_nonvert_repul_step(tstep,trajdir,max,ownship,repac,epsv) >= 0) ||
       any_conflict_step(conflict_det,tstep,B,T,trajdir,max,ownship,traffic) ||
@@ -378,8 +488,9 @@ bool KinematicIntegerBands::any_int_red(Detection3D* conflict_det, Detection3D*
     double B, double T, double B2, double T2,
     int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const TrafficState& repac,
     int epsh, int epsv, int dir) const {
-  bool leftred = dir <= 0 && red_band_exist(conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic,repac,epsh,epsv);
-  bool rightred = dir >= 0 && red_band_exist(conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic,repac,epsh,epsv);
+  traffic_arrays.set(ownship,traffic);
+  bool leftred = dir <= 0 && red_band_exist(conflict_det,recovery_det,tstep,B,T,B2,T2,false,maxl,ownship,traffic_arrays,repac,epsh,epsv);
+  bool rightred = dir >= 0 && red_band_exist(conflict_det,recovery_det,tstep,B,T,B2,T2,true,maxr,ownship,traffic_arrays,repac,epsh,epsv);
   return leftred || rightred;
 }
 
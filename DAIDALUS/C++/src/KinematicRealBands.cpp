@@ -11,12 +11,17 @@
 #include "IntervalSet.h"
 #include "Util.h"
 #include "Detection3D.h"
+#include "Detection3DRegistry.h"
 #include "ACCoRDConfig.h"
 #include "CDCylinder.h"
+#include "CD3D.h"
+#include "CriteriaCore.h"
+#include "string_util.h"
 #include "BandsRegion.h"
 #include "format.h"
 #include <vector>
 #include <string>
+#include <algorithm>
 
 namespace larcfm {
 
@@ -29,6 +34,7 @@ KinematicRealBands::KinematicRealBands() {
   max = 0;
   step = 0;
   do_recovery = false;
+  pruned_traffic = 0;
 }
 
 KinematicRealBands::KinematicRealBands(double min_d, double max_d, double step_d, bool recovery_b) {
@@ -40,6 +46,7 @@ KinematicRealBands::KinematicRealBands(double min_d, double max_d, double step_d
   max = max_d;
   step = step_d;
   do_recovery = recovery_b;
+  pruned_traffic = 0;
 }
 
 KinematicRealBands::KinematicRealBands(const KinematicRealBands& b) {
@@ -51,6 +58,7 @@ KinematicRealBands::KinematicRealBands(const KinematicRealBands& b) {
   max = b.max;
   step = b.step;
   do_recovery = b.do_recovery;
+  pruned_traffic = 0;
 }
 
 double KinematicRealBands::getMin() const {
@@ -99,17 +107,38 @@ void KinematicRealBands::setRecovery(bool flag) {
 
 bool KinematicRealBands::kinematicConflict(const KinematicBandsCore& core, const TrafficState& repac, double T,
     const OwnshipState& ownship, const TrafficState& ac) const {
-  std::vector<TrafficState> alerting_set;
-  alerting_set.push_back(ac);
-  return any_red(core.detector,NULL,repac,0,T,ownship,alerting_set);
+  single_traffic.resize(1);
+  single_traffic[0] = ac;
+  return any_red(core.detector,NULL,repac,0,T,ownship,single_traffic);
 }
 
 std::pair<std::vector<TrafficState>,std::vector<TrafficState> > KinematicRealBands::alertingAircraft(const KinematicBandsCore& core) const {
+  return alertingAircraft(core,core.traffic);
+}
+
+std::pair<std::vector<TrafficState>,std::vector<TrafficState> > KinematicRealBands::alertingAircraft(const KinematicBandsCore& core,
+    const std::vector<TrafficState>& traffic) const {
   std::vector<TrafficState> preventive;
   std::vector<TrafficState> corrective;
+  alertingAircraft(core,traffic,preventive,corrective);
+  return std::pair<std::vector<TrafficState>,std::vector<TrafficState> >(preventive,corrective);
+}
+
+void KinematicRealBands::alertingAircraft(const KinematicBandsCore& core, const std::vector<TrafficState>& traffic,
+    std::vector<TrafficState>& preventive, std::vector<TrafficState>& corrective) const {
+  preventive.clear();
+  corrective.clear();
   double A = core.alertingTime();
-  for (int i = 0; i < core.trafficSize(); ++i) {
-    TrafficState ac = core.getTraffic(i);
+  double gso = max_ownship_gs(core.ownship);
+  double vso = max_ownship_vs(core.ownship);
+  Vect3 so = core.own_s();
+  for (int i = 0; i < (int) traffic.size(); ++i) {
+    const TrafficState& ac = traffic[i];
+    Velocity vi = core.traffic_v(ac);
+    if (core.detector->unreachable(so.Sub(core.traffic_s(ac)),gso+vi.gs(),vso+std::abs(vi.z),A)) {
+      ++pruned_traffic;
+      continue;
+    }
     ConflictData det = core.checkConflict(ac,0,A);
     if (det.conflict()) {
       corrective.push_back(ac);
@@ -117,7 +146,6 @@ std::pair<std::vector<TrafficState>,std::vector<TrafficState> > KinematicRealBan
       preventive.push_back(ac);
     }
   }
-  return std::pair<std::vector<TrafficState>,std::vector<TrafficState> >(preventive,corrective);
 }
 
 std::pair< std::vector<std::string>,std::vector<std::string> > KinematicRealBands::alertingAircraftNames(const KinematicBandsCore& core) const {
@@ -135,6 +163,18 @@ std::pair< std::vector<std::string>,std::vector<std::string> > KinematicRealBand
   return std::pair<std::vector<std::string>,std::vector<std::string> >(preventive,corrective);
 }
 
+int KinematicRealBands::prunedTrafficCount() const {
+  return pruned_traffic;
+}
+
+double KinematicRealBands::max_ownship_gs(const OwnshipState& ownship) const {
+  return ownship.get_v().gs();
+}
+
+double KinematicRealBands::max_ownship_vs(const OwnshipState& ownship) const {
+  return std::abs(ownship.get_v().z);
+}
+
 double KinematicRealBands::recoveryTime(KinematicBandsCore& core) {
   recompute(core);
   return recovery_time;
@@ -162,6 +202,16 @@ BandsRegion::Region KinematicRealBands::region(KinematicBandsCore& core, int i)
   return regions[i];
 }
 
+const std::vector<Interval>& KinematicRealBands::getIntervals(KinematicBandsCore& core) {
+  recompute(core);
+  return intervals;
+}
+
+const std::vector<BandsRegion::Region>& KinematicRealBands::getRegions(KinematicBandsCore& core) {
+  recompute(core);
+  return regions;
+}
+
 BandsRegion::Region KinematicRealBands::regionOf(KinematicBandsCore& core, double val) {
   if (!core.hasOwnship() || val < min || val > max) {
     return BandsRegion::UNKNOWN;
@@ -200,12 +250,32 @@ void KinematicRealBands::reset() {
   intervals.clear();
   regions.clear();
   recovery_time = 0;
+  outdated_traffic.clear();
+  clear_trajectory_cache();
+}
+
+void KinematicRealBands::resetTraffic(const std::string& id) {
+  if (!outdated) {
+    intervals.clear();
+    regions.clear();
+    recovery_time = 0;
+    if (std::find(outdated_traffic.begin(),outdated_traffic.end(),id) == outdated_traffic.end()) {
+      outdated_traffic.push_back(id);
+    }
+  }
 }
 
 void KinematicRealBands::recompute(KinematicBandsCore& core) {
   if (core.hasOwnship() && outdated) {
     compute(core);
     outdated = false;
+    outdated_traffic.clear();
+  } else if (core.hasOwnship() && !outdated_traffic.empty()) {
+    for (int i = 0; i < (int) outdated_traffic.size(); ++i) {
+      compute_traffic_none_bands(core,outdated_traffic[i]);
+    }
+    outdated_traffic.clear();
+    combine_traffic_none_bands(core);
   }
 }
 
@@ -251,30 +321,95 @@ void KinematicRealBands::color_bands(const IntervalSet& bands, bool greenbands,
   }
 }
 
+// Largest factor k such that the current trajectories of ownship and alerting_set are free of conflict, in
+// the time interval [0,T], with respect to a cylinder of diameter k*D and height k*H. The factor is given by
+// the cylindrical distance at the time of cylindrical closest point of approach.
+double KinematicRealBands::clear_scale(double D, double H, double T, const OwnshipState& ownship,
+    const std::vector<TrafficState>& alerting_set) {
+  double scale = PINFINITY;
+  Vect3 so = ownship.get_s();
+  Velocity vo = ownship.get_v();
+  for (int i = 0; i < (int) alerting_set.size(); ++i) {
+    Vect3 s = so.Sub(ownship.traffic_s(alerting_set[i]));
+    Velocity vi = ownship.traffic_v(alerting_set[i]);
+    double t = CD3D::tccpa(s,vo,vi,D,H,T);
+    scale = std::min(scale,vo.Sub(vi).ScalAdd(t,s).cyl_norm(D,H));
+  }
+  return scale;
+}
+
 // compute recovery bands
 void KinematicRealBands::compute_recovery_bands(IntervalSet& noneset, KinematicBandsCore& core,
     const std::vector<TrafficState>& alerting_set) {
   double T = core.maxRecoveryTime();
   TrafficState repac = core.recovery_crit ? core.getTraffic(core.criteria_ac) : TrafficState::INVALID;
   CDCylinder cd3d = CDCylinder::mk(ACCoRDConfig::NMAC_D,ACCoRDConfig::NMAC_H);
-  none_bands(noneset,&cd3d,NULL,repac,0,T,core.ownship,alerting_set);
-  if (!noneset.isEmpty()) {
+  noneset.clear();
+  if (exists_green(&cd3d,NULL,repac,0,T,core.ownship,alerting_set,NULL)) {
     // If solid red, nothing to do. No way to kinematically escape using vertical speed without intersecting the
     // NMAC cylinder
-    cd3d = CDCylinder::mk(core.minHorizontalRecovery(),core.minVerticalRecovery());
-    while (cd3d.getHorizontalSeparation() > ACCoRDConfig::NMAC_D || cd3d.getVerticalSeparation() > ACCoRDConfig::NMAC_H) {
+    // Recovery cylinders, from the minimum recovery separation down to the NMAC cylinder, each one 0.8 times
+    // the previous one
+    double D = core.minHorizontalRecovery();
+    double H = core.minVerticalRecovery();
+    recovery_D.clear();
+    recovery_H.clear();
+    while (D > ACCoRDConfig::NMAC_D || H > ACCoRDConfig::NMAC_H) {
+      recovery_D.push_back(D);
+      recovery_H.push_back(H);
+      D *= 0.8;
+      H *= 0.8;
+    }
+    int n = recovery_D.size();
+    if (n == 0) {
+      // The minimum recovery cylinder is within the NMAC cylinder: the bands are the ones of the NMAC cylinder
       none_bands(noneset,&cd3d,NULL,repac,0,T,core.ownship,alerting_set);
-      bool solidred = noneset.isEmpty();
+      return;
+    }
+    // Index of the first cylinder to try. Without corrective bands, only the largest cylinder is tried.
+    int first = 0;
+    bool searched = false;
+    if (core.ca_bands && n > 1 && recovery_D[0] > 0 && recovery_H[0] > 0) {
+      // Since a larger cylinder contains a smaller one, the cylinders for which there is a green band are
+      // all those from a certain index on. That index is found by bisection, starting at the first cylinder
+      // that the current trajectories of the aircraft clear.
+      int red = -1;
+      int green = n;
+      double scale = clear_scale(recovery_D[0],recovery_H[0],T,core.ownship,alerting_set);
+      int k = 0;
+      while (k < n-1 && recovery_D[k] > scale*recovery_D[0]) {
+        ++k;
+      }
+      while (green-red > 1) {
+        cd3d = CDCylinder::mk(recovery_D[k],recovery_H[k]);
+        if (exists_green(&cd3d,NULL,repac,0,T,core.ownship,alerting_set,NULL)) {
+          green = k;
+        } else {
+          red = k;
+        }
+        k = (red+green)/2;
+      }
+      if (green == n) {
+        return;
+      }
+      first = green;
+      searched = true;
+    }
+    for (int i = first; i < n; ++i) {
+      cd3d = CDCylinder::mk(recovery_D[i],recovery_H[i]);
+      bool solidred = !(i == first && searched) && !exists_green(&cd3d,NULL,repac,0,T,core.ownship,alerting_set,NULL);
       if (solidred && !core.ca_bands) {
         return;
       } else if (!solidred) {
-        // Find first green band
+        // Find first green band. Probes only differ in their time interval, so they share
+        // loss of separation results.
+        LosCache& cache = recovery_los;
+        cache.clear();
         double pivot_red = 0;
         double pivot_green = T+1;
         double pivot = pivot_green-1;
         while ((pivot_green-pivot_red) > 1) {
-          none_bands(noneset,core.detector,&cd3d,repac,pivot,T,core.ownship,alerting_set);
-          solidred = noneset.isEmpty();
+          solidred = !exists_green(core.detector,&cd3d,repac,pivot,T,core.ownship,alerting_set,&cache);
           if (solidred) {
             pivot_red = pivot;
           } else {
@@ -296,40 +431,93 @@ void KinematicRealBands::compute_recovery_bands(IntervalSet& noneset, KinematicB
           return;
         }
       }
-      cd3d.setHorizontalSeparation(cd3d.getHorizontalSeparation()*0.8);
-      cd3d.setVerticalSeparation(cd3d.getVerticalSeparation()*0.8);
     }
   }
 }
 
 // compute all bands
 void KinematicRealBands::compute(KinematicBandsCore& core) {
-  std::pair<std::vector<TrafficState>,std::vector<TrafficState> > alerting_aircraft = alertingAircraft(core);
-  std::vector<TrafficState> alerting_set;
-  alerting_set.insert(alerting_set.begin(),alerting_aircraft.first.begin(),alerting_aircraft.first.end());
-  alerting_set.insert(alerting_set.end(),alerting_aircraft.second.begin(), alerting_aircraft.second.end());
+  // Entries are overwritten rather than cleared, so that their storage is reused
+  std::map<std::string,TrafficNoneBands>::iterator it = traffic_none_bands.begin();
+  while (it != traffic_none_bands.end()) {
+    if (core.getTraffic(it->first).isValid()) {
+      ++it;
+    } else {
+      traffic_none_bands.erase(it++);
+    }
+  }
+  for (int i = 0; i < core.trafficSize(); ++i) {
+    bool first = true;
+    for (int j = 0; j < i && first; ++j) {
+      first = core.traffic[j].getId() != core.traffic[i].getId();
+    }
+    if (first) {
+      compute_traffic_none_bands(core,core.traffic[i].getId());
+    }
+  }
+  combine_traffic_none_bands(core);
+}
+
+void KinematicRealBands::compute_traffic_none_bands(const KinematicBandsCore& core, const std::string& id) {
+  id_traffic.clear();
+  for (int i = 0; i < core.trafficSize(); ++i) {
+    if (core.traffic[i].getId() == id) {
+      id_traffic.push_back(core.traffic[i]);
+    }
+  }
+  alertingAircraft(core,id_traffic,preventive_traffic,corrective_traffic);
+  TrafficNoneBands& entry = traffic_none_bands[id];
+  entry.alerting = !preventive_traffic.empty() || !corrective_traffic.empty();
+  if (entry.alerting) {
+    TrafficState repac = core.conflict_crit ? core.getTraffic(core.criteria_ac) : TrafficState::INVALID;
+    compute_none_bands(entry.none,core,repac,preventive_traffic,corrective_traffic);
+  }
+}
+
+void KinematicRealBands::combine_traffic_none_bands(KinematicBandsCore& core) {
+  recovery_time = 0;
   IntervalSet noneset;
-  if (alerting_set.empty()) {
+  bool alerting = false;
+  for (std::map<std::string,TrafficNoneBands>::const_iterator it = traffic_none_bands.begin();
+      it != traffic_none_bands.end() && !(alerting && noneset.isEmpty()); ++it) {
+    if (!it->second.alerting) {
+      continue;
+    }
+    if (alerting) {
+      noneset.almost_intersect(it->second.none);
+    } else {
+      noneset = it->second.none;
+      alerting = true;
+    }
+  }
+  if (!alerting) {
     noneset.almost_add(min,max);
   } else {
-    TrafficState repac = core.conflict_crit ? core.getTraffic(core.criteria_ac) : TrafficState::INVALID;
-    compute_none_bands(noneset,core,repac,alerting_aircraft);
     bool solidred = noneset.isEmpty();
     if (solidred) {
       recovery_time = -1;
       if (do_recovery) {
-        compute_recovery_bands(noneset,core,alerting_set);
+        alertingAircraft(core,core.traffic,preventive_traffic,corrective_traffic);
+        alerting_traffic.clear();
+        alerting_traffic.insert(alerting_traffic.end(),preventive_traffic.begin(),preventive_traffic.end());
+        alerting_traffic.insert(alerting_traffic.end(),corrective_traffic.begin(),corrective_traffic.end());
+        compute_recovery_bands(noneset,core,alerting_traffic);
       }
     }
   }
   color_bands(noneset,true,core.implicit_bands,recovery_time > 0);
 }
 
-bool KinematicRealBands::solid_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
-    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) {
+bool KinematicRealBands::exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const {
   IntervalSet noneset;
   none_bands(noneset,conflict_det,recovery_det,repac,B,T,ownship,traffic);
-  return noneset.isEmpty();
+  return !noneset.isEmpty();
+}
+
+bool KinematicRealBands::solid_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) {
+  return !exists_green(conflict_det,recovery_det,repac,B,T,ownship,traffic,NULL);
 }
 
 bool KinematicRealBands::all_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
@@ -343,13 +531,139 @@ bool KinematicRealBands::any_green(Detection3D* conflict_det, Detection3D* recov
 }
 
 void KinematicRealBands::compute_none_bands(IntervalSet& noneset, const KinematicBandsCore& core, const TrafficState& repac,
-    const std::pair<std::vector<TrafficState>,std::vector<TrafficState> >& alerting_aircraft) {
-  none_bands(noneset,core.detector,NULL,repac,0,core.alertingTime(),core.ownship,alerting_aircraft.first);
+    const std::vector<TrafficState>& preventive, const std::vector<TrafficState>& corrective) {
+  none_bands(noneset,core.detector,NULL,repac,0,core.alertingTime(),core.ownship,preventive);
   IntervalSet noneset2;
-  none_bands(noneset2,core.detector,NULL,repac,0,core.lookahead,core.ownship,alerting_aircraft.second);
+  none_bands(noneset2,core.detector,NULL,repac,0,core.lookahead,core.ownship,corrective);
   noneset.almost_intersect(noneset2);
 }
 
+bool KinematicRealBands::instantaneous_bands() const {
+  return false;
+}
+
+double KinematicRealBands::instantaneous_value(const Velocity& v) const {
+  return 0;
+}
+
+Velocity KinematicRealBands::instantaneous_velocity(const Velocity& v, double val) const {
+  return v;
+}
+
+void KinematicRealBands::critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+    double D, double H, double B, double T) const {
+}
+
+static bool is_cylinder(Detection3D* det) {
+  return det == NULL || det->getClassTag() == Detection3DRegistry::TAG_CDCYLINDER;
+}
+
+bool KinematicRealBands::instantaneous_green(Detection3D* conflict_det, Detection3D* recovery_det, double B, double T,
+    const OwnshipState& ownship, const std::vector<TrafficState>& traffic, const Velocity& nvo,
+    const TrafficState& repac, int epsh, int epsv) const {
+  Vect3 so = ownship.get_s();
+  for (int i = 0; i < (int) traffic.size(); ++i) {
+    Vect3 si = ownship.traffic_s(traffic[i]);
+    Velocity vi = ownship.traffic_v(traffic[i]);
+    if ((B <= T && conflict_det->conflict(so,nvo,si,vi,B,T)) ||
+        (recovery_det != NULL && recovery_det->conflict(so,nvo,si,vi,0,B))) {
+      return false;
+    }
+  }
+  if (repac.isValid() && (epsh != 0 || epsv != 0)) {
+    Vect3 s = so.Sub(ownship.traffic_s(repac));
+    Velocity vo = ownship.get_v();
+    Velocity vi = ownship.traffic_v(repac);
+    return (epsh == 0 || CriteriaCore::horizontal_new_repulsive_criterion(s,vo,vi,nvo,epsh)) &&
+        (epsv == 0 || CriteriaCore::vertical_new_repulsive_criterion(s,vo,vi,nvo,epsv));
+  }
+  return true;
+}
+
+bool KinematicRealBands::instantaneous_none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (repac.isValid() || !is_cylinder(conflict_det) || !is_cylinder(recovery_det)) {
+    return false;
+  }
+  Vect3 so = ownship.get_s();
+  Velocity vo = ownship.get_v();
+  std::vector<double>& vals = critical_vals;
+  vals.clear();
+  for (int i = 0; i < (int) traffic.size(); ++i) {
+    Vect3 s = so.Sub(ownship.traffic_s(traffic[i]));
+    Velocity vi = ownship.traffic_v(traffic[i]);
+    if (B <= T) {
+      CDCylinder* cd = (CDCylinder*)conflict_det;
+      critical_values(vals,s,vo,vi,cd->getHorizontalSeparation(),cd->getVerticalSeparation(),B,T);
+    }
+    if (recovery_det != NULL && B > 0) {
+      CDCylinder* cd = (CDCylinder*)recovery_det;
+      critical_values(vals,s,vo,vi,cd->getHorizontalSeparation(),cd->getVerticalSeparation(),0,B);
+    }
+  }
+  // Conflict status only changes at critical values, so it is enough to check one value in
+  // each of the intervals they delimit
+  std::vector<double>& splits = critical_splits;
+  splits.clear();
+  splits.push_back(min);
+  for (int i = 0; i < (int) vals.size(); ++i) {
+    if (min < vals[i] && vals[i] < max) {
+      splits.push_back(vals[i]);
+    }
+  }
+  splits.push_back(max);
+  std::sort(splits.begin(),splits.end());
+  noneset.clear();
+  for (int i = 1; i < (int) splits.size(); ++i) {
+    double lb = splits[i-1];
+    double ub = splits[i];
+    if (lb < ub && instantaneous_green(conflict_det,recovery_det,B,T,ownship,traffic,
+        instantaneous_velocity(vo,(lb+ub)/2.0),TrafficState::INVALID,0,0)) {
+      noneset.almost_add(lb,ub);
+    }
+  }
+  return true;
+}
+
+void KinematicRealBands::instantaneous_bands_combine(std::vector<Integerval>& l, Detection3D* conflict_det, Detection3D* recovery_det,
+    double B, double T, double scal, int maxl, int maxr, const OwnshipState& ownship, const std::vector<TrafficState>& traffic,
+    const TrafficState& repac, int epsh, int epsv) const {
+  Velocity vo = ownship.get_v();
+  double val = instantaneous_value(vo);
+  l.clear();
+  int lb = 0;
+  bool green = false;
+  for (int j = -maxl; j <= maxr; ++j) {
+    // As in the kinematic case, the current velocity is always repulsive
+    bool jgreen = instantaneous_green(conflict_det,recovery_det,B,T,ownship,traffic,
+        instantaneous_velocity(vo,val+j*scal),j == 0 ? TrafficState::INVALID : repac,epsh,epsv);
+    if (jgreen && !green) {
+      lb = j;
+    } else if (!jgreen && green) {
+      l.push_back(Integerval(lb,j-1));
+    }
+    green = jgreen;
+  }
+  if (green) {
+    l.push_back(Integerval(lb,maxr));
+  }
+}
+
+bool KinematicRealBands::instantaneous_any_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  IntervalSet noneset;
+  none_bands(noneset,conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  return noneset.size() != 1 || !Util::almost_leq(noneset.getInterval(0).low,min) ||
+      !Util::almost_geq(noneset.getInterval(0).up,max);
+}
+
+bool KinematicRealBands::instantaneous_all_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  IntervalSet noneset;
+  none_bands(noneset,conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  return noneset.isEmpty();
+}
+
 std::string KinematicRealBands::toString() const {
   std::string s = "";
   for (int i = 0; i < (int) intervals.size(); ++i) {
@@ -5,6 +5,7 @@
  * Rights Reserved.
  */
 #include "KinematicTrkBands.h"
+#include "CriticalVectors.h"
 #include "Vect3.h"
 #include "Velocity.h"
 #include "Position.h"
@@ -15,22 +16,26 @@
 #include "BandsRegion.h"
 #include "Integerval.h"
 #include "ProjectedKinematics.h"
+#include "Kinematics.h"
 #include <cmath>
 #include "DefaultDaidalusParameters.h"
 
 
 namespace larcfm {
 
-KinematicTrkBands::KinematicTrkBands() {
+KinematicTrkBands::KinematicTrkBands() : KinematicTrkBands(*DefaultDaidalusParameters::getSnapshot()) {
+}
+
+KinematicTrkBands::KinematicTrkBands(const DaidalusParameters& parameters) {
   intervals = std::vector<Interval>();
   regions = std::vector<BandsRegion::Region>();
   recovery_time = 0;
   min = 0;
   max = 2*Pi;
-  step = DefaultDaidalusParameters::getTrackStep();
-  do_recovery = DefaultDaidalusParameters::isEnabledRecoveryTrackBands();
-  turn_rate = DefaultDaidalusParameters::getTurnRate();
-  bank_angle = DefaultDaidalusParameters::getBankAngle();
+  step = parameters.getTrackStep();
+  do_recovery = parameters.isEnabledRecoveryTrackBands();
+  turn_rate = parameters.getTurnRate();
+  bank_angle = parameters.getBankAngle();
 }
 
 KinematicTrkBands::KinematicTrkBands(const KinematicTrkBands& b) {
@@ -86,9 +91,13 @@ bool KinematicTrkBands::almostNear(KinematicBandsCore& core, double val, double
 }
 
 std::pair<Vect3, Velocity> KinematicTrkBands::trajectory(const OwnshipState& ownship, double time, bool dir) const {
-  double bank = (turn_rate == 0 || ownship.getVelocity().gs() <= Units::from("kn",1)) ?
+  double bank = (turn_rate == 0 || ownship.getVelocity().gs() <= Units::kn) ?
       bank_angle : std::abs(Kinematics::bankAngle(ownship.getVelocity().gs(),turn_rate));
   double R = Kinematics::turnRadius(ownship.get_v().gs(), bank);
+  if (!ownship.isLatLon()) {
+    // Euclidean ownship: the projected state is the state itself
+    return Kinematics::turn(ownship.get_s(),ownship.get_v(),time,R,dir);
+  }
   std::pair<Position,Velocity> posvel = ProjectedKinematics::turn(ownship.getPosition(),ownship.getVelocity(),time,R,dir);
   return std::pair<Vect3, Velocity>(ownship.pos_to_s(posvel.first),ownship.vel_to_v(posvel.first,posvel.second));
 }
@@ -100,8 +109,11 @@ std::pair<Vect3, Velocity> KinematicTrkBands::trajectory(const OwnshipState& own
 
 bool KinematicTrkBands::any_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
     double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    return instantaneous_any_red(conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  }
   double gso = ownship.getVelocity().gs();
-  double omega = turn_rate == 0 || gso <= Units::from("kn",1) ? Kinematics::turnRate(gso,bank_angle) : turn_rate;
+  double omega = turn_rate == 0 || gso <= Units::kn ? Kinematics::turnRate(gso,bank_angle) : turn_rate;
   int maxn = (int)round(Pi/step);
   double tstep = step/omega;
   int epsh = 0;
@@ -112,8 +124,11 @@ bool KinematicTrkBands::any_red(Detection3D* conflict_det, Detection3D* recovery
 
 bool KinematicTrkBands::all_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
     double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    return instantaneous_all_red(conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  }
   double gso = ownship.getVelocity().gs();
-  double omega = turn_rate == 0 || gso <= Units::from("kn",1) ? Kinematics::turnRate(gso,bank_angle) : turn_rate;
+  double omega = turn_rate == 0 || gso <= Units::kn ? Kinematics::turnRate(gso,bank_angle) : turn_rate;
   int maxn = (int)round(Pi/step);
   double tstep = step/omega;
   int epsh = 0;
@@ -125,12 +140,26 @@ bool KinematicTrkBands::all_red(Detection3D* conflict_det, Detection3D* recovery
 
 void KinematicTrkBands::none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac, double B, double T,
     const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    if (!instantaneous_none_bands(noneset,conflict_det,recovery_det,repac,B,T,ownship,traffic)) {
+      double trko = ownship.getVelocity().trk();
+      int maxn = (int)round(Pi/step);
+      std::vector<Integerval>& trkint = int_bands;
+      int epsh = 0;
+      if (repac.isValid()) {
+        epsh = KinematicBandsCore::epsilonH(ownship,repac);
+      }
+      instantaneous_bands_combine(trkint,conflict_det,recovery_det,B,T,Pi/maxn,maxn,maxn,ownship,traffic,repac,epsh,0);
+      toIntervalSet_0_2PI(noneset,trkint,Pi/maxn,trko);
+    }
+    return;
+  }
   double gso = ownship.getVelocity().gs();
-  double omega = turn_rate == 0 || gso <= Units::from("kn",1) ? Kinematics::turnRate(gso,bank_angle) : turn_rate;
+  double omega = turn_rate == 0 || gso <= Units::kn ? Kinematics::turnRate(gso,bank_angle) : turn_rate;
   double trko = ownship.getVelocity().trk();
   int maxn = (int)round(Pi/step);
   double tstep = step/omega;
-  std::vector<Integerval> trkint = std::vector<Integerval>();
+  std::vector<Integerval>& trkint = int_bands;
   int epsh = 0;
   if (repac.isValid()) {
     epsh = KinematicBandsCore::epsilonH(ownship,repac);
@@ -139,4 +168,43 @@ void KinematicTrkBands::none_bands(IntervalSet& noneset, Detection3D* conflict_d
   toIntervalSet_0_2PI(noneset,trkint,Pi/maxn,trko);
 }
 
+bool KinematicTrkBands::exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const {
+  if (instantaneous_bands()) {
+    return KinematicRealBands::exists_green(conflict_det,recovery_det,repac,B,T,ownship,traffic,cache);
+  }
+  double gso = ownship.getVelocity().gs();
+  double omega = turn_rate == 0 || gso <= Units::kn ? Kinematics::turnRate(gso,bank_angle) : turn_rate;
+  double trko = ownship.getVelocity().trk();
+  int maxn = (int)round(Pi/step);
+  double tstep = step/omega;
+  int epsh = 0;
+  if (repac.isValid()) {
+    epsh = KinematicBandsCore::epsilonH(ownship,repac);
+  }
+  // Track bands wrap around, so any green step is in range
+  return any_int_green(conflict_det,recovery_det,tstep,B,T,0,B,maxn,maxn,ownship,traffic,repac,epsh,0,
+      Pi/maxn,trko,NINFINITY,PINFINITY,cache);
+}
+
+bool KinematicTrkBands::instantaneous_bands() const {
+  return turn_rate == 0 && bank_angle == 0;
+}
+
+double KinematicTrkBands::instantaneous_value(const Velocity& v) const {
+  return v.trk();
+}
+
+Velocity KinematicTrkBands::instantaneous_velocity(const Velocity& v, double val) const {
+  return v.mkTrk(val);
+}
+
+void KinematicTrkBands::critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+    double D, double H, double B, double T) const {
+  std::list<Vect2> trks = CriticalVectors::tracks(s,vo,vi,D,H,B,T);
+  for (std::list<Vect2>::const_iterator it = trks.begin(); it != trks.end(); ++it) {
+    vals.push_back(it->compassAngle());
+  }
+}
+
 }
@@ -5,6 +5,7 @@
  * Rights Reserved.
  */
 #include "KinematicVsBands.h"
+#include "CriticalVectors.h"
 #include "Vect3.h"
 #include "Velocity.h"
 #include "Position.h"
@@ -15,21 +16,25 @@
 #include "BandsRegion.h"
 #include "Integerval.h"
 #include "ProjectedKinematics.h"
+#include "Kinematics.h"
 #include <cmath>
 #include "DefaultDaidalusParameters.h"
 
 
 namespace larcfm {
 
-KinematicVsBands::KinematicVsBands() {
+KinematicVsBands::KinematicVsBands() : KinematicVsBands(*DefaultDaidalusParameters::getSnapshot()) {
+}
+
+KinematicVsBands::KinematicVsBands(const DaidalusParameters& parameters) {
   intervals = std::vector<Interval>();
   regions = std::vector<BandsRegion::Region>();
   recovery_time = 0;
-  min = DefaultDaidalusParameters::getMinVerticalSpeed();
-  max = DefaultDaidalusParameters::getMaxVerticalSpeed();
-  step = DefaultDaidalusParameters::getVerticalSpeedStep();
-  do_recovery = DefaultDaidalusParameters::isEnabledRecoveryVerticalSpeedBands();
-  vertical_accel = DefaultDaidalusParameters::getVerticalAcceleration();
+  min = parameters.getMinVerticalSpeed();
+  max = parameters.getMaxVerticalSpeed();
+  step = parameters.getVerticalSpeedStep();
+  do_recovery = parameters.isEnabledRecoveryVerticalSpeedBands();
+  vertical_accel = parameters.getVerticalAcceleration();
 }
 
 KinematicVsBands::KinematicVsBands(const KinematicVsBands& b) {
@@ -55,6 +60,12 @@ double KinematicVsBands::getVerticalAcceleration() const {
 }
 
 std::pair<Vect3, Velocity> KinematicVsBands::trajectory(const OwnshipState& ownship, double time, bool dir) const {
+  if (!ownship.isLatLon()) {
+    // Euclidean ownship: the projected state is the state itself
+    Velocity vo = ownship.get_v();
+    double a = (dir?1:-1)*vertical_accel;
+    return std::pair<Vect3,Velocity>(Kinematics::vsAccelPos(ownship.get_s(),vo,time,a),Velocity::mkVxyz(vo.x,vo.y,vo.z+a*time));
+  }
   std::pair<Position,Velocity> posvel = ProjectedKinematics::vsAccel(ownship.getPosition(),ownship.getVelocity(),time,
       (dir?1:-1)*vertical_accel);
   return std::pair<Vect3,Velocity>(ownship.pos_to_s(posvel.first),ownship.vel_to_v(posvel.first,posvel.second));
@@ -62,6 +73,9 @@ std::pair<Vect3, Velocity> KinematicVsBands::trajectory(const OwnshipState& owns
 
 bool KinematicVsBands::any_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
     double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    return instantaneous_any_red(conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  }
   double vso = ownship.getVelocity().vs();
   int maxdown = (int)std::max(std::ceil((vso-min)/step),0.0)+1;
   int maxup = (int)std::max(std::ceil((max-vso)/step),0.0)+1;
@@ -75,6 +89,9 @@ bool KinematicVsBands::any_red(Detection3D* conflict_det, Detection3D* recovery_
 
 bool KinematicVsBands::all_red(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
     double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    return instantaneous_all_red(conflict_det,recovery_det,repac,B,T,ownship,traffic);
+  }
   double vso = ownship.getVelocity().vs();
   int maxdown = (int)std::max(std::ceil((vso-min)/step),0.0)+1;
   int maxup = (int)std::max(std::ceil((max-vso)/step),0.0)+1;
@@ -88,11 +105,26 @@ bool KinematicVsBands::all_red(Detection3D* conflict_det, Detection3D* recovery_
 
 void KinematicVsBands::none_bands(IntervalSet& noneset, Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac, double B, double T,
     const OwnshipState& ownship, const std::vector<TrafficState>& traffic) const {
+  if (instantaneous_bands()) {
+    if (!instantaneous_none_bands(noneset,conflict_det,recovery_det,repac,B,T,ownship,traffic)) {
+      double vso = ownship.getVelocity().vs();
+      int maxdown = (int)std::max(std::ceil((vso-min)/step),0.0)+1;
+      int maxup = (int)std::max(std::ceil((max-vso)/step),0.0)+1;
+      std::vector<Integerval>& vsint = int_bands;
+      int epsv = 0;
+      if (repac.isValid()) {
+        epsv = KinematicBandsCore::epsilonV(ownship,repac);
+      }
+      instantaneous_bands_combine(vsint,conflict_det,recovery_det,B,T,step,maxdown,maxup,ownship,traffic,repac,0,epsv);
+      KinematicIntegerBands::toIntervalSet(noneset,vsint,step,vso,min,max);
+    }
+    return;
+  }
   double vso = ownship.getVelocity().vs();
   int maxdown = (int)std::max(std::ceil((vso-min)/step),0.0)+1;
   int maxup = (int)std::max(std::ceil((max-vso)/step),0.0)+1;
   double tstep = step/vertical_accel;
-  std::vector<Integerval> vsint = std::vector<Integerval>();
+  std::vector<Integerval>& vsint = int_bands;
   int epsv = 0;
   if (repac.isValid()) {
     epsv = KinematicBandsCore::epsilonV(ownship,repac);
@@ -101,4 +133,44 @@ void KinematicVsBands::none_bands(IntervalSet& noneset, Detection3D* conflict_de
   KinematicIntegerBands::toIntervalSet(noneset,vsint,step,vso,min,max);
 }
 
+bool KinematicVsBands::exists_green(Detection3D* conflict_det, Detection3D* recovery_det, const TrafficState& repac,
+    double B, double T, const OwnshipState& ownship, const std::vector<TrafficState>& traffic, LosCache* cache) const {
+  if (instantaneous_bands()) {
+    return KinematicRealBands::exists_green(conflict_det,recovery_det,repac,B,T,ownship,traffic,cache);
+  }
+  double vso = ownship.getVelocity().vs();
+  int maxdown = (int)std::max(std::ceil((vso-min)/step),0.0)+1;
+  int maxup = (int)std::max(std::ceil((max-vso)/step),0.0)+1;
+  double tstep = step/vertical_accel;
+  int epsv = 0;
+  if (repac.isValid()) {
+    epsv = KinematicBandsCore::epsilonV(ownship,repac);
+  }
+  return any_int_green(conflict_det,recovery_det,tstep,B,T,0,B,maxdown,maxup,ownship,traffic,repac,0,epsv,
+      step,vso,min,max,cache);
+}
+
+double KinematicVsBands::max_ownship_vs(const OwnshipState& ownship) const {
+  // Kinematic maneuvers may overshoot min and max by the last steps of the search
+  return std::max(std::abs(ownship.get_v().z),std::max(std::abs(min),std::abs(max)))+2*step;
+}
+
+bool KinematicVsBands::instantaneous_bands() const {
+  return vertical_accel == 0;
+}
+
+double KinematicVsBands::instantaneous_value(const Velocity& v) const {
+  return v.vs();
+}
+
+Velocity KinematicVsBands::instantaneous_velocity(const Velocity& v, double val) const {
+  return v.mkVs(val);
+}
+
+void KinematicVsBands::critical_values(std::vector<double>& vals, const Vect3& s, const Vect3& vo, const Vect3& vi,
+    double D, double H, double B, double T) const {
+  std::list<double> vss = CriticalVectors::verticalSpeeds(s,vo,vi,D,H,B,T);
+  vals.insert(vals.end(),vss.begin(),vss.end());
+}
+
 }
@@ -24,7 +24,7 @@ namespace larcfm {
       s = eprj.project(pos);
       v = eprj.projectVelocity(pos,vel);
     } else {
-      eprj = Projection::createProjection(Position::ZERO_LL());
+      // The projection of a Euclidean ownship is never used, and it is not built
       s = pos.point();
       v = vel;
     }
@@ -36,7 +36,6 @@ namespace larcfm {
       s = eprj.project(pos);
       v = eprj.projectVelocity(pos,vel);
     } else {
-      eprj = Projection::createProjection(Position::ZERO_LL());
       s = pos.point();
       v = vel;
     }
@@ -46,6 +45,9 @@ namespace larcfm {
   const OwnshipState OwnshipState::INVALID = OwnshipState();
   
   Velocity OwnshipState::inverseVelocity(const Velocity& v) const {
+    if (!pos.isLatLon()) {
+      return v;
+    }
     return eprj.inverseVelocity(s,v,true);
   }
     
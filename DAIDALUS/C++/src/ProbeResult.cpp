@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "ProbeResult.h"
+#include "Util.h"
+#include "format.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+ProbeResult::ProbeResult() {
+  time_in = PINFINITY;
+}
+
+void ProbeResult::clear() {
+  time_in = PINFINITY;
+  aircraft.clear();
+}
+
+void ProbeResult::add(int ac, double t) {
+  aircraft.push_back(ac);
+  time_in = std::min(time_in,t);
+}
+
+bool ProbeResult::conflict() const {
+  return !aircraft.empty();
+}
+
+double ProbeResult::getTimeIn() const {
+  return time_in;
+}
+
+const std::vector<int>& ProbeResult::getAircraft() const {
+  return aircraft;
+}
+
+std::string ProbeResult::toString() const {
+  std::string s = "conflict: "+Fmb(conflict());
+  if (conflict()) {
+    s += ", time in: "+Fm2(time_in)+", aircraft:";
+    for (int k = 0; k < (int) aircraft.size(); ++k) {
+      s += " "+Fm0(aircraft[k]);
+    }
+  }
+  return s;
+}
+
+}
@@ -20,13 +20,16 @@
 #include "AziEquiProjection.h"
 #include "LatLonAlt.h"
 #include "string_util.h"
+#include <mutex>
 #include <string>
 
 namespace larcfm {
 
   // the default!!!
-  EuclideanProjection Projection::projection = EuclideanProjection();
-  ProjectionType Projection::ptype = projection_type_value__;
+  const EuclideanProjection Projection::projection = EuclideanProjection();
+  const ProjectionType Projection::ptype = projection_type_value__;
+  ErrorLog Projection::error("Projection");
+  std::mutex Projection::mutex;
 
   EuclideanProjection Projection::createProjection(double lat, double lon, double alt) {
     return projection.makeNew(lat, lon, alt);
@@ -51,8 +54,23 @@ namespace larcfm {
     return projection.maxRange();
   }
 
-  // void in C++
-  void Projection::setProjectionType(ProjectionType t) {  }
+  // The projection type is chosen at compile time in C++
+  void Projection::setProjectionType(ProjectionType t) {
+    if (t != ptype) {
+      std::lock_guard<std::mutex> lock(mutex);
+      error.addWarning(ErrorLog::INVALID_VALUE,"setProjectionType: the projection type is fixed at compile time, the call has no effect");
+    }
+  }
+
+  bool Projection::hasMessage() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return error.hasMessage();
+  }
+
+  std::string Projection::getMessage() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return error.getMessage();
+  }
 
 
   ProjectionType Projection::getProjectionTypeFromString(std::string s) {
@@ -96,8 +114,9 @@ namespace larcfm {
 	  return Projection::projectionMaxRange();
   }
 
-  // void in C++
-  void setProjectionType(ProjectionType t) {  }
+  void setProjectionType(ProjectionType t) {
+	  Projection::setProjectionType(t);
+  }
 
 
   ProjectionType getProjectionTypeFromString(std::string s) {
@@ -5,6 +5,7 @@
  * Rights Reserved.
  */
 #include "TCAS3D.h"
+#include "Detection3DRegistry.h"
 #include "TCAS2D.h"
 #include "CD2D.h"
 #include "CD3D.h"
@@ -14,11 +15,14 @@
 #include "Util.h"
 #include "Vertical.h"
 #include "ConflictData.h"
+#include "TrafficArrays.h"
 #include <cfloat>
+#include <cmath>
+#include <algorithm>
 
 namespace larcfm {
 
-bool TCAS3D::pvsCheck = false;
+std::atomic<bool> TCAS3D::pvsCheck(false);
 
 TCAS3D::TCAS3D() {
   table = TCASTable(true);
@@ -43,13 +47,107 @@ bool TCAS3D::violation(const Vect3& so, const Velocity& vo, const Vect3& si, con
 }
 
 bool TCAS3D::conflict(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const {
-  return RA3D(so,vo,si,vi,B,T).conflict();
+  if (pvsCheck) {
+    return RA3D(so,vo,si,vi,B,T).conflict();
+  }
+  return RA3D_conflict(thresholds(so.z),so,vo,si,vi,B,T);
 }
 
 ConflictData TCAS3D::conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const {
   return RA3D(so,vo,si,vi,B,T);
 }
 
+TCAS3D::RAThresholds TCAS3D::thresholds(double alt) const {
+  int sl = TCASTable::getSensitivityLevel(alt);
+  RAThresholds th;
+  th.usehmdf = table.getHMDFilter();
+  th.TAU  = table.getTAU(sl);
+  th.DMOD = table.getDMOD(sl);
+  th.HMD  = table.getHMD(sl);
+  th.ZTHR = table.getZTHR(sl);
+  return th;
+}
+
+/**
+ * The sensitivity level only depends on the ownship altitude, so the values of the TCAS table are looked up
+ * once. Supersets of the vertical and horizontal tests of the resolution advisory are done first for a block
+ * of aircraft, in a loop over the traffic arrays. The full test is only done for the aircraft that pass them.
+ */
+bool TCAS3D::anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const {
+  RAThresholds th = thresholds(so.z);
+  int n = traffic.size();
+  char keep[TrafficArrays::BLOCK];
+  for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+    int m = std::min(n-i0,TrafficArrays::BLOCK);
+    const double* sx = traffic.sx.data()+i0;
+    const double* sy = traffic.sy.data()+i0;
+    const double* sz = traffic.sz.data()+i0;
+    const double* vx = traffic.vx.data()+i0;
+    const double* vy = traffic.vy.data()+i0;
+    const double* vz = traffic.vz.data()+i0;
+    // Superset of vertical_RA(so.z-si.z,vo.z-vi.z,ZTHR,TAU) && TCAS2D::horizontal_RA(DMOD,TAU,s,v)
+    for (int j = 0; j < m; ++j) {
+      double x = so.x-(t*vx[j]+sx[j]);
+      double y = so.y-(t*vy[j]+sy[j]);
+      double z = so.z-(t*vz[j]+sz[j]);
+      double sdotv = x*(vo.x-vx[j])+y*(vo.y-vy[j]);
+      double tcoa = -z/(vo.z-vz[j]);
+      keep[j] = ((std::abs(z) <= th.ZTHR) | ((0 <= tcoa) & (tcoa <= th.TAU))) &
+          ((sdotv < 0) | (std::sqrt(x*x+y*y) <= th.DMOD));
+    }
+    for (int j = 0; j < m; ++j) {
+      if (keep[j]) {
+        Velocity vi = traffic.v(i0+j);
+        if (TCASII_RA(th,so,vo,vi.ScalAdd(t,traffic.s(i0+j)),vi)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * The values of the TCAS table are looked up once. An aircraft is only checked when it passes a superset of the
+ * vertical tests of RA3D_interval: the altitude difference is within ZTHR, or the aircraft reaches the vertical
+ * thresholds within [B,T].
+ */
+bool TCAS3D::anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const {
+  if (pvsCheck) {
+    return Detection3D::anyConflict(so,vo,traffic,t,B,T);
+  }
+  if (T <= B) {
+    T = DBL_MAX;
+  }
+  RAThresholds th = thresholds(so.z);
+  int n = traffic.size();
+  char keep[TrafficArrays::BLOCK];
+  for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+    int m = std::min(n-i0,TrafficArrays::BLOCK);
+    const double* sz = traffic.sz.data()+i0;
+    const double* vz = traffic.vz.data()+i0;
+    // Same entry and exit times as in RA3D_interval, when vo.z and vi.z are not almost equal
+    for (int j = 0; j < m; ++j) {
+      double z = so.z-(t*vz[j]+sz[j]);
+      double nzvz = vo.z-vz[j];
+      double sign = nzvz >= 0 ? 1 : -1;
+      double act_H = std::max(th.ZTHR,std::abs(nzvz)*th.TAU);
+      double centry = (-sign*act_H-z)/nzvz;
+      double cexit = (sign*th.ZTHR-z)/nzvz;
+      keep[j] = (std::abs(z) <= th.ZTHR) | ((nzvz != 0) & (B <= cexit) & (centry <= T));
+    }
+    for (int j = 0; j < m; ++j) {
+      if (keep[j]) {
+        Velocity vi = traffic.v(i0+j);
+        if (RA3D_conflict(th,so,vo,vi.ScalAdd(t,traffic.s(i0+j)),vi,B,T)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
 double time_coalt(double sz, double voz, double viz, double h) {
   if (std::abs(sz) <= h)
     return 0;
@@ -79,6 +177,10 @@ bool cd2d_TCAS(double HMD, Vect2 s, Vect2 vo, Vect2 vi) {
 
 // if true, then ownship has a TCAS resolution advisory at current time
 bool TCAS3D::TCASII_RA(const Vect3& so, const Vect3& vo, const Vect3& si, const Vect3& vi) const {
+  return TCASII_RA(thresholds(so.z),so,vo,si,vi);
+}
+
+bool TCAS3D::TCASII_RA(const RAThresholds& th, const Vect3& so, const Vect3& vo, const Vect3& si, const Vect3& vi) const {
 
   Vect2 so2 = so.vect2();
   Vect2 si2 = si.vect2();
@@ -86,16 +188,10 @@ bool TCAS3D::TCASII_RA(const Vect3& so, const Vect3& vo, const Vect3& si, const
   Vect2 vo2 = vo.vect2();
   Vect2 vi2 = vi.vect2();
   Vect2 v2 = vo2.Sub(vi2);
-  int sl = TCASTable::getSensitivityLevel(so.z);
-  bool usehmdf = table.getHMDFilter();
-  double TAU  = table.getTAU(sl);
-  double DMOD = table.getDMOD(sl);
-  double HMD  = table.getHMD(sl);
-  double ZTHR = table.getZTHR(sl);
 
-  return (!usehmdf || cd2d_TCAS(HMD,s2,vo2,vi2)) &&
-      TCAS2D::horizontal_RA(DMOD,TAU,s2,v2) &&
-      vertical_RA(so.z-si.z,vo.z-vi.z,ZTHR,TAU);
+  return (!th.usehmdf || cd2d_TCAS(th.HMD,s2,vo2,vi2)) &&
+      TCAS2D::horizontal_RA(th.DMOD,th.TAU,s2,v2) &&
+      vertical_RA(so.z-si.z,vo.z-vi.z,th.ZTHR,th.TAU);
 }
 
 // if true, within lookahead time interval [B,T], the ownship has a TCAS resolution advisory (effectively conflict detection)
@@ -201,6 +297,59 @@ ConflictData TCAS3D::RA3D_interval(const Vect3& so, const Velocity& vo, const Ve
   return ConflictData(time_in,time_out,time_mintau,dist_mintau);
 }
 
+bool TCAS3D::RA3D_conflict(const RAThresholds& th, const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const {
+  if (T <= B) {
+    T = DBL_MAX;
+  }
+  Vect2 so2 = so.vect2();
+  Vect2 si2 = si.vect2();
+  Vect2 s2 = so2.Sub(si2);
+  Vect2 vo2 = vo.vect2();
+  Vect2 vi2 = vi.vect2();
+  Vect2 v2 = vo2.Sub(vi2);
+  if (th.usehmdf && !cd2d_TCAS_after(th.HMD,s2,vo2,vi2,B)) {
+    return false;
+  }
+  double sz = so.z-si.z;
+  if (Util::almost_equals(vo.z, vi.z) && std::abs(sz) > th.ZTHR) {
+    return false;
+  }
+  double nzvz = vo.z-vi.z;
+  double centry = B;
+  double cexit  = T;
+  if (!Util::almost_equals(vo.z, vi.z)) {
+    double act_H = std::max(th.ZTHR,std::abs(nzvz)*th.TAU);
+    centry = Vertical::Theta_H(sz,nzvz,-1,act_H);
+    cexit = Vertical::Theta_H(sz,nzvz,1,th.ZTHR);
+  }
+  if (cexit < B || T < centry) {
+    return false;
+  }
+  Vect2 ventry = v2.ScalAdd(centry,s2);
+  bool exit_at_centry = ventry.dot(v2) >= 0;
+  bool los_at_centry = ventry.sqv() <= Util::sq(th.HMD);
+  double tin = std::max(B,centry);
+  double tout = std::min(T,cexit);
+  TCAS2D tcas2d;
+  tcas2d.RA2D_interval(th.DMOD,th.TAU,tin,tout,s2,vo2,vi2);
+  double RAin2D = tcas2d.t_in;
+  double RAout2D = tcas2d.t_out;
+  if (RAin2D > RAout2D || RAout2D<tin || RAin2D > tout ||
+      (th.usehmdf && th.HMD < th.DMOD && exit_at_centry && !los_at_centry)) {
+    return false;
+  }
+  double time_in = std::max(tin,std::min(tout,RAin2D));
+  double time_out = std::max(tin,std::min(tout,RAout2D));
+  if (th.usehmdf && th.HMD < th.DMOD) {
+    double exitTheta = T;
+    if (v2.sqv() > 0)
+      exitTheta = std::max(B,std::min(Horizontal::Theta_D(s2,v2,1,th.HMD),T));
+    time_out = std::min(time_out,exitTheta);
+  }
+  // Same as LossData(time_in,time_out).conflict()
+  return time_in < time_out && !Util::almost_equals(time_in,time_out);
+}
+
 // pointer to new instance of this object
 TCAS3D* TCAS3D::make() const {
   return new TCAS3D();
@@ -245,7 +394,7 @@ void TCAS3D::setIdentifier(const std::string& s) {
 }
 
 bool TCAS3D::equals(Detection3D* d) const {
-  if (!larcfm::equals(getCanonicalClassName(), d->getCanonicalClassName())) return false;
+  if (getClassTag() != d->getClassTag()) return false;
   if (!larcfm::equals(id, d->getIdentifier())) return false;
   if (!table.equals(((TCAS3D*)d)->table)) return false;
   return true;
@@ -255,6 +404,14 @@ std::string TCAS3D::getSimpleClassName() const {
   return "TCAS3D";
 }
 
+int TCAS3D::getClassTag() const {
+  return Detection3DRegistry::TAG_TCAS3D;
+}
+
+int TCAS3D::getSuperClassTag() const {
+  return Detection3DRegistry::TAG_TCAS3D;
+}
+
 
 void TCAS3D::print_PVS_input(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const {
   if (pvsCheck) {
@@ -286,7 +443,7 @@ std::string TCAS3D::toString() const {
 }
 
 bool TCAS3D::contains(const Detection3D* cd) const {
-  if (larcfm::equals(getCanonicalClassName(), cd->getCanonicalClassName())) {
+  if (getClassTag() == cd->getClassTag()) {
     TCAS3D* d = (TCAS3D*)cd;
     return table.contains(d->table);
   }
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "ThreadPool.h"
+
+namespace larcfm {
+
+ThreadPool::ThreadPool(int n) {
+  stop = false;
+  for (int i = 0; i < n; ++i) {
+    workers.push_back(std::thread(&ThreadPool::worker,this));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  for (int i = 0; i < (int) workers.size(); ++i) {
+    workers[i].join();
+  }
+}
+
+int ThreadPool::size() const {
+  return workers.size();
+}
+
+// The mutex is held by the caller
+void ThreadPool::finish(int* pending) {
+  if (--(*pending) == 0) {
+    cv.notify_all();
+  }
+}
+
+void ThreadPool::worker() {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    while (!stop && queue.empty()) {
+      cv.wait(lock);
+    }
+    if (queue.empty()) {
+      return;
+    }
+    Task t = queue.front();
+    queue.pop_front();
+    lock.unlock();
+    (*t.f)();
+    lock.lock();
+    finish(t.pending);
+  }
+}
+
+void ThreadPool::run(const std::vector<std::function<void()> >& tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+  int pending = tasks.size();
+  if (tasks.size() > 1) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 1; i < (int) tasks.size(); ++i) {
+      Task t = { &tasks[i], &pending };
+      queue.push_back(t);
+    }
+  }
+  cv.notify_all();
+  tasks[0]();
+  std::unique_lock<std::mutex> lock(mutex);
+  finish(&pending);
+  // Help with queued tasks, which may belong to other groups, until this group is done
+  while (pending > 0) {
+    if (queue.empty()) {
+      cv.wait(lock);
+    } else {
+      Task t = queue.front();
+      queue.pop_front();
+      lock.unlock();
+      (*t.f)();
+      lock.lock();
+      finish(t.pending);
+    }
+  }
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "TrafficArrays.h"
+#include "Vect3.h"
+#include "Velocity.h"
+#include "TrafficState.h"
+#include "OwnshipState.h"
+#include <vector>
+
+namespace larcfm {
+
+const int TrafficArrays::BLOCK;
+
+TrafficArrays::TrafficArrays() {
+}
+
+TrafficArrays::TrafficArrays(const OwnshipState& ownship, const std::vector<TrafficState>& traffic) {
+  set(ownship,traffic);
+}
+
+void TrafficArrays::set(const OwnshipState& ownship, const std::vector<TrafficState>& traffic) {
+  int n = traffic.size();
+  sx.resize(n);
+  sy.resize(n);
+  sz.resize(n);
+  vx.resize(n);
+  vy.resize(n);
+  vz.resize(n);
+  for (int i = 0; i < n; ++i) {
+    Vect3 si = ownship.traffic_s(traffic[i]);
+    Velocity vi = ownship.traffic_v(traffic[i]);
+    sx[i] = si.x;
+    sy[i] = si.y;
+    sz[i] = si.z;
+    vx[i] = vi.x;
+    vy[i] = vi.y;
+    vz[i] = vi.z;
+  }
+}
+
+void TrafficArrays::clear() {
+  sx.clear();
+  sy.clear();
+  sz.clear();
+  vx.clear();
+  vy.clear();
+  vz.clear();
+}
+
+int TrafficArrays::size() const {
+  return sx.size();
+}
+
+bool TrafficArrays::isEmpty() const {
+  return sx.empty();
+}
+
+Vect3 TrafficArrays::s(int i) const {
+  return Vect3(sx[i],sy[i],sz[i]);
+}
+
+Velocity TrafficArrays::v(int i) const {
+  return Velocity::mkVxyz(vx[i],vy[i],vz[i]);
+}
+
+}
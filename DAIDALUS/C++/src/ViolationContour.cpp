@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#include "ViolationContour.h"
+#include "Detection3D.h"
+#include "OwnshipState.h"
+#include "TrafficState.h"
+#include "ConflictData.h"
+#include "CriticalVectors.h"
+#include "CD3D.h"
+#include "Detection3DRegistry.h"
+#include "Interval.h"
+#include "Position.h"
+#include "Units.h"
+#include "Util.h"
+#include "format.h"
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+ViolationContour::ViolationContour() {
+  trk_tol = Units::from("deg",0.1);
+  dist_tol = 50;
+  max_step = Units::from("deg",1);
+  calls = 0;
+}
+
+ViolationContour::ViolationContour(double trk, double d, double step) {
+  trk_tol = trk;
+  dist_tol = d;
+  max_step = step;
+  calls = 0;
+}
+
+ViolationContour::Sample ViolationContour::sample(double trk, const Detection3D* detector, const OwnshipState& own,
+    const Vect3& si, const Velocity& vi, double B, double T) {
+  Velocity vo = own.vel_to_v(own.getPosition(),own.getVelocity().mkTrk(trk));
+  ConflictData det = detector->conflictDetection(own.get_s(),vo,si,vi,B,T);
+  ++calls;
+  Sample smp;
+  smp.trk = trk;
+  smp.conflict = det.conflict();
+  smp.time_in = det.getTimeIn();
+  smp.time_out = det.getTimeOut();
+  if (smp.conflict) {
+    smp.s_in = vo.ScalAdd(smp.time_in,own.get_s());
+    smp.s_out = vo.ScalAdd(smp.time_out,own.get_s());
+  }
+  return smp;
+}
+
+bool ViolationContour::chord_ok(const Sample& a, const Sample& m, const Sample& b) const {
+  return a.s_in.Add(b.s_in).Scal(0.5).Sub(m.s_in).vect2().norm() <= dist_tol &&
+      a.s_out.Add(b.s_out).Scal(0.5).Sub(m.s_out).vect2().norm() <= dist_tol;
+}
+
+// Appends to samples the samples in (a.trk,b.trk], where boundaries of regions are found by bisection and
+// regions are subdivided until their polylines are within the distance tolerance
+void ViolationContour::refine(const Sample& a, const Sample& b, const Detection3D* detector, const OwnshipState& own,
+    const Vect3& si, const Velocity& vi, double B, double T, std::vector<Sample>& samples) {
+  if (b.trk-a.trk <= trk_tol || (!a.conflict && !b.conflict)) {
+    samples.push_back(b);
+    return;
+  }
+  Sample m = sample((a.trk+b.trk)/2,detector,own,si,vi,B,T);
+  if (a.conflict && b.conflict && m.conflict && chord_ok(a,m,b)) {
+    samples.push_back(m);
+    samples.push_back(b);
+    return;
+  }
+  refine(a,m,detector,own,si,vi,B,T,samples);
+  refine(m,b,detector,own,si,vi,B,T,samples);
+}
+
+// Sets arcs to intervals of tracks that contain all the tracks in conflict. When the detector provides violation
+// bounds, these are the tracks in conflict with a cylinder that contains the violation volume. Arcs are
+// increasing, their lower bounds are in [0,2pi), and they have length at most 2pi. Returns true when the arcs
+// are exactly the tracks in conflict, i.e., when the violation volume is the cylinder of CDCylinder.
+bool ViolationContour::candidate_arcs(const Detection3D* detector, const OwnshipState& own, const Vect3& si, const Velocity& vi,
+    double B, double T, std::vector<Interval>& arcs) {
+  arcs.clear();
+  Velocity vo = own.get_v();
+  double D = detector->horizontalViolationBound(vo.gs()+vi.gs());
+  double H = detector->verticalViolationBound(std::abs(vo.z-vi.z));
+  if (D < 0 || H < 0 || !(0 <= B && B < T) || ISINF(T)) {
+    arcs.push_back(Interval(0,2*Pi));
+    return false;
+  }
+  bool exact = detector->getClassTag() == Detection3DRegistry::TAG_CDCYLINDER;
+  if (!exact) {
+    // Relative slack that absorbs rounding errors, and the difference between projected and actual tracks
+    double eps = 1E-6;
+    D += eps*(1+D);
+    H += eps*(1+H);
+  }
+  Vect3 s = own.get_s().Sub(si);
+  std::list<Vect2> crit = CriticalVectors::tracks(s,vo,vi,D,H,B,T);
+  std::vector<double> trks;
+  for (std::list<Vect2>::const_iterator it = crit.begin(); it != crit.end(); ++it) {
+    trks.push_back(it->compassAngle());
+  }
+  if (trks.empty()) {
+    if (CD3D::cd3d(s,vo,vi,D,H,B,T)) {
+      arcs.push_back(Interval(0,2*Pi));
+    }
+    return exact;
+  }
+  std::sort(trks.begin(),trks.end());
+  int n = trks.size();
+  // Between consecutive critical tracks, either all tracks or no track is in conflict with the cylinder
+  for (int k = 0; k < n; ++k) {
+    double lo = trks[k];
+    double up = k+1 < n ? trks[k+1] : trks[0]+2*Pi;
+    if (lo < up && CD3D::cd3d(s,vo.mkTrk((lo+up)/2),vi,D,H,B,T)) {
+      if (!arcs.empty() && arcs.back().up == lo) {
+        arcs.back() = Interval(arcs.back().low,up);
+      } else {
+        arcs.push_back(Interval(lo,up));
+      }
+    }
+  }
+  // Join the arcs that meet at north
+  if (arcs.size() > 1 && arcs.back().up == arcs[0].low+2*Pi) {
+    arcs[0] = Interval(arcs.back().low,arcs[0].up+2*Pi);
+    arcs.pop_back();
+  }
+  return exact;
+}
+
+void ViolationContour::compute(const Detection3D* detector, const OwnshipState& own, const TrafficState& ac, double B, double T) {
+  clear();
+  Position pi = ac.getPosition();
+  Vect3 si = own.pos_to_s(pi);
+  Velocity vi = own.vel_to_v(pi,ac.getVelocity());
+  std::vector<Interval> arcs;
+  bool exact = candidate_arcs(detector,own,si,vi,B,T,arcs);
+  for (int i = 0; i < (int) arcs.size(); ++i) {
+    double lo = arcs[i].low;
+    double up = arcs[i].up;
+    bool circle = up-lo >= 2*Pi;
+    // Exact arcs are in conflict at all tracks, samples are only needed to refine the polylines
+    int n = exact ? 2 : std::max(2,(int) std::ceil((up-lo)/max_step));
+    std::vector<Sample> samples;
+    Sample a = sample(lo,detector,own,si,vi,B,T);
+    samples.push_back(a);
+    for (int k = 1; k <= n; ++k) {
+      Sample b = a;
+      if (circle && k == n) {
+        b = samples[0];
+        b.trk += 2*Pi;
+      } else {
+        b = sample(lo+k*(up-lo)/n,detector,own,si,vi,B,T);
+      }
+      refine(a,b,detector,own,si,vi,B,T,samples);
+      a = b;
+    }
+    if (exact) {
+      // The arc is one region. Samples at its bounds may be tangent to the cylinder, hence not in conflict.
+      regions.push_back(Region());
+      for (int k = 0; k < (int) samples.size(); ++k) {
+        if (samples[k].conflict && !(circle && k+1 == (int) samples.size())) {
+          append(samples[k],own);
+        }
+      }
+      if (regions.back().trks.empty()) {
+        regions.pop_back();
+      } else {
+        regions.back().low = lo;
+        regions.back().up = up;
+      }
+      continue;
+    }
+    if (circle) {
+      // Start the samples at a track that is not in conflict, so that no region is split at lo
+      int k0 = 0;
+      while (k0 < (int) samples.size() && samples[k0].conflict) {
+        ++k0;
+      }
+      if (k0 == (int) samples.size()) {
+        regions.push_back(Region());
+        for (int k = 0; k < (int) samples.size(); ++k) {
+          append(samples[k],own);
+        }
+        continue;
+      }
+      samples.pop_back();
+      std::rotate(samples.begin(),samples.begin()+k0,samples.end());
+      for (int k = (int) samples.size()-k0; k < (int) samples.size(); ++k) {
+        samples[k].trk += 2*Pi;
+      }
+      samples.push_back(samples[0]);
+      samples.back().trk += 2*Pi;
+    }
+    for (int k = 0; k < (int) samples.size(); ++k) {
+      if (samples[k].conflict) {
+        if (k == 0 || !samples[k-1].conflict) {
+          regions.push_back(Region());
+        }
+        append(samples[k],own);
+      }
+    }
+  }
+  // Lower bounds of the regions are in [0,2pi)
+  for (int i = 0; i < (int) regions.size(); ++i) {
+    std::vector<double>& trks = regions[i].trks;
+    double shift = std::floor(regions[i].low/(2*Pi))*2*Pi;
+    for (int k = 0; k < (int) trks.size(); ++k) {
+      trks[k] -= shift;
+    }
+    regions[i].low -= shift;
+    regions[i].up -= shift;
+  }
+}
+
+void ViolationContour::append(const Sample& smp, const OwnshipState& own) {
+  Position po = own.getPosition();
+  Velocity vo = own.getVelocity().mkTrk(smp.trk);
+  if (regions.back().trks.empty()) {
+    regions.back().low = smp.trk;
+  }
+  regions.back().up = smp.trk;
+  regions.back().trks.push_back(smp.trk);
+  regions.back().entries.push_back(po.linear(vo,smp.time_in));
+  regions.back().exits.push_back(po.linear(vo,smp.time_out));
+}
+
+void ViolationContour::clear() {
+  regions.clear();
+  calls = 0;
+}
+
+int ViolationContour::size() const {
+  return regions.size();
+}
+
+Interval ViolationContour::getTrackInterval(int i) const {
+  return Interval(regions[i].low,regions[i].up);
+}
+
+const std::vector<double>& ViolationContour::getTracks(int i) const {
+  return regions[i].trks;
+}
+
+const std::vector<Position>& ViolationContour::getEntries(int i) const {
+  return regions[i].entries;
+}
+
+const std::vector<Position>& ViolationContour::getExits(int i) const {
+  return regions[i].exits;
+}
+
+int ViolationContour::detectorCalls() const {
+  return calls;
+}
+
+double ViolationContour::getTrackTolerance() const {
+  return trk_tol;
+}
+
+void ViolationContour::setTrackTolerance(double trk) {
+  trk_tol = trk;
+}
+
+double ViolationContour::getDistanceTolerance() const {
+  return dist_tol;
+}
+
+void ViolationContour::setDistanceTolerance(double d) {
+  dist_tol = d;
+}
+
+double ViolationContour::getMaxStep() const {
+  return max_step;
+}
+
+void ViolationContour::setMaxStep(double trk) {
+  max_step = trk;
+}
+
+std::string ViolationContour::toString() const {
+  std::string s = "";
+  for (int i = 0; i < (int) regions.size(); ++i) {
+    s += getTrackInterval(i).toStringUnits("deg")+" ("+Fm0((int) regions[i].trks.size())+" samples)\n";
+  }
+  return s;
+}
+
+}
@@ -6,6 +6,7 @@
  */
 #include "WCV_tvar.h"
 #include "WCV_TAUMOD.h"
+#include "Detection3DRegistry.h"
 #include "WCV_TCPA.h"
 #include "Vect3.h"
 #include "Velocity.h"
@@ -28,45 +29,6 @@ WCV_TAUMOD::WCV_TAUMOD(const WCVTable& tab) {
   id = "";
 }
 
-double WCV_TAUMOD::horizontal_tvar(const Vect2& s, const Vect2& v) const {
-  // Time variable is Modified Tau
-  double taumod = -1;
-  double sdotv = s.dot(v);
-  if (sdotv < 0)
-    return (Util::sq(table.getDTHR())-s.sqv())/sdotv;
-  return taumod;
-}
-
-LossData WCV_TAUMOD::horizontal_WCV_interval(double T, const Vect2& s, const Vect2& v) const {
-  double time_in = T;
-  double time_out = 0;
-  double sqs = s.sqv();
-  double sdotv = s.dot(v);
-  double sqD = Util::sq(table.getDTHR());
-  double a = v.sqv();
-  double b = 2*sdotv+table.getTTHR()*v.sqv();
-  double c = sqs+table.getTTHR()*sdotv-sqD;
-  if (Util::almost_equals(a,0) && sqs <= sqD) { // [CAM] Changed from == to almost_equals to mitigate numerical problems
-    time_in = 0;
-    time_out = T;
-    return LossData(time_in,time_out);
-  }
-  if (sqs <= sqD) {
-    time_in = 0;
-    time_out = std::min(T,Horizontal::Theta_D(s,v,1,table.getDTHR()));
-    return LossData(time_in,time_out);
-  }
-  double discr = Util::sq(b)-4*a*c;
-  if (sdotv >= 0 || discr < 0)
-    return LossData(time_in,time_out);
-  double t = (-b - std::sqrt(discr))/(2*a);
-  if (Horizontal::Delta(s, v,table.getDTHR()) >= 0 && t <= T) {
-    time_in = std::max(0.0,t);
-    time_out = std::min(T, Horizontal::Theta_D(s,v,1,table.getDTHR()));
-  }
-  return LossData(time_in,time_out);
-}
-
 Detection3D* WCV_TAUMOD::make() const {
   return new WCV_TAUMOD();
 }
@@ -85,12 +47,16 @@ std::string WCV_TAUMOD::getSimpleClassName() const {
   return "WCV_TAUMOD";
 }
 
+int WCV_TAUMOD::getClassTag() const {
+  return Detection3DRegistry::TAG_WCV_TAUMOD;
+}
+
 bool WCV_TAUMOD::contains(const Detection3D* cd) const {
-  if (larcfm::equals(getCanonicalClassName(), cd->getCanonicalClassName())) {
+  if (getClassTag() == cd->getClassTag()) {
     WCV_TAUMOD* d = (WCV_TAUMOD*)cd;
     return table.contains(d->table);
   }
-  if (larcfm::equals("gov.nasa.larcfm.ACCoRD.WCV_TCPA", cd->getCanonicalClassName())) {
+  if (cd->getClassTag() == Detection3DRegistry::TAG_WCV_TCPA) {
     WCVTable tab = ((WCV_TCPA*)cd)->getWCVTable();
     return table.contains(tab);
   }
@@ -6,6 +6,7 @@
  */
 #include "WCV_Vertical.h"
 #include "Vertical.h"
+#include "Packed.h"
 
 namespace larcfm {
 
@@ -42,4 +43,90 @@ void WCV_Vertical::vertical_WCV_interval(double ZTHR, double TCOA, double B, dou
   time_out = std::min(T,texit);
 }
 
+#if DAIDALUS_PACKED
+// Packed values do not cross function calls, since the functions of Packed are inlined (see Packed.h)
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// Packed loop of vertical_WCV_block, from index j
+class VerticalWCVLanes {
+public:
+  char* keep;
+  int j, n;
+  double ZTHR, TCOA, z, wz, t;
+  const double* sz;
+  const double* vz;
+
+  template <int N>
+  DAIDALUS_PACKED_INLINE void run() {
+    typedef Packed<N> P;
+    for (; j+N <= n; j += N) {
+      typename P::vec vzj = P::load(vz+j);
+      P::store(keep+j,P::vertical_WCV(ZTHR,TCOA,z-(t*vzj+P::load(sz+j)),wz-vzj));
+    }
+  }
+};
+
+// Packed loop of vertical_WCV_interval_block, from index j
+class VerticalWCVIntervalLanes {
+public:
+  char* keep;
+  int j, n;
+  double ZTHR, TCOA, B, T, z, wz, t;
+  const double* sz;
+  const double* vz;
+
+  template <int N>
+  DAIDALUS_PACKED_INLINE void run() {
+    typedef Packed<N> P;
+    for (; j+N <= n; j += N) {
+      // Most groups are discarded by the reachability test
+      bool any = false;
+      for (int k = 0; k < N; ++k) {
+        any |= keep[j+k] != 0;
+      }
+      if (!any) {
+        continue;
+      }
+      typename P::vec vzj = P::load(vz+j);
+      typename P::vec time_in, time_out;
+      P::vertical_WCV_interval(ZTHR,TCOA,B,T,z-(t*vzj+P::load(sz+j)),wz-vzj,time_in,time_out);
+      typename P::mask ok = ~(time_in > time_out);
+      for (int k = 0; k < N; ++k) {
+        keep[j+k] = keep[j+k] && ok[k];
+      }
+    }
+  }
+};
+#endif
+
+void WCV_Vertical::vertical_WCV_block(char* keep, int n, double ZTHR, double TCOA, double z, double wz, double t,
+    const double* sz, const double* vz) {
+  int j = 0;
+#if DAIDALUS_PACKED
+  VerticalWCVLanes lanes = {keep,0,n,ZTHR,TCOA,z,wz,t,sz,vz};
+  packed_run(lanes);
+  j = lanes.j;
+#endif
+  for (; j < n; ++j) {
+    keep[j] = vertical_WCV(ZTHR,TCOA,z-(t*vz[j]+sz[j]),wz-vz[j]);
+  }
+}
+
+void WCV_Vertical::vertical_WCV_interval_block(char* keep, int n, double ZTHR, double TCOA, double B, double T,
+    double z, double wz, double t, const double* sz, const double* vz) {
+  int j = 0;
+#if DAIDALUS_PACKED
+  VerticalWCVIntervalLanes lanes = {keep,0,n,ZTHR,TCOA,B,T,z,wz,t,sz,vz};
+  packed_run(lanes);
+  j = lanes.j;
+#endif
+  WCV_Vertical vertical;
+  for (; j < n; ++j) {
+    if (keep[j]) {
+      vertical.vertical_WCV_interval(ZTHR,TCOA,B,T,z-(t*vz[j]+sz[j]),wz-vz[j]);
+      keep[j] = !(vertical.time_in > vertical.time_out);
+    }
+  }
+}
+
 }
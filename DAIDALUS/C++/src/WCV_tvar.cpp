@@ -5,6 +5,7 @@
  * Rights Reserved.
  */
 #include "WCV_tvar.h"
+#include "Detection3DRegistry.h"
 #include "Vect3.h"
 #include "Velocity.h"
 #include "WCV_Vertical.h"
@@ -15,11 +16,14 @@
 #include "LossData.h"
 #include "format.h"
 #include "string_util.h"
+#include "TrafficArrays.h"
 #include <cfloat>
+#include <algorithm>
+#include <cmath>
 
 namespace larcfm {
 
-bool WCV_tvar::pvsCheck = false;
+std::atomic<bool> WCV_tvar::pvsCheck(false);
 
 WCVTable WCV_tvar::getWCVTable() {
   return table;
@@ -105,6 +109,74 @@ bool WCV_tvar::violation(const Vect3& so, const Velocity& vo, const Vect3& si, c
       WCV_Vertical::vertical_WCV(table.getZTHR(),table.getTCOA(),so.z-si.z,vo.z-vi.z);
 }
 
+/**
+ * The vertical test is done first for a block of aircraft, in a loop over the traffic arrays. The
+ * horizontal test, which depends on the time variable, is only done for the aircraft that pass it.
+ */
+bool WCV_tvar::anyViolation(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t) const {
+  double ZTHR = table.getZTHR();
+  double TCOA = table.getTCOA();
+  Vect2 so2 = so.vect2();
+  Vect2 vo2 = vo.vect2();
+  int n = traffic.size();
+  char keep[TrafficArrays::BLOCK];
+  for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+    int m = std::min(n-i0,TrafficArrays::BLOCK);
+    const double* sz = traffic.sz.data()+i0;
+    const double* vz = traffic.vz.data()+i0;
+    // Same as WCV_Vertical::vertical_WCV(ZTHR,TCOA,so.z-si.z,vo.z-vi.z)
+    for (int j = 0; j < m; ++j) {
+      double z = so.z-(t*vz[j]+sz[j]);
+      double wz = vo.z-vz[j];
+      keep[j] = (std::abs(z) <= ZTHR) | ((wz != 0) & (z*wz <= 0) & (-z/wz <= TCOA));
+    }
+    for (int j = 0; j < m; ++j) {
+      if (keep[j]) {
+        Velocity vi = traffic.v(i0+j);
+        Vect3 si = vi.ScalAdd(t,traffic.s(i0+j));
+        if (horizontal_WCV(so2.Sub(si.vect2()),vo2.Sub(vi.vect2()))) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Only the aircraft that can reach the violation bounds of this detector within [B,T] are checked.
+ */
+bool WCV_tvar::anyConflict(const Vect3& so, const Velocity& vo, const TrafficArrays& traffic, double t, double B, double T) const {
+  int n = traffic.size();
+  char keep[TrafficArrays::BLOCK];
+  for (int i0 = 0; i0 < n; i0 += TrafficArrays::BLOCK) {
+    int m = std::min(n-i0,TrafficArrays::BLOCK);
+    reachable_block(keep,i0,m,so,vo,traffic,t,B,T,table.getDTHR(),table.getTTHR(),table.getZTHR(),table.getTCOA());
+    for (int j = 0; j < m; ++j) {
+      if (keep[j]) {
+        Velocity vi = traffic.v(i0+j);
+        if (conflict(so,vo,vi.ScalAdd(t,traffic.s(i0+j)),vi,B,T)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * A horizontal violation requires either a distance of at most DTHR, or a time variable of at most
+ * TTHR and a distance at closest point of approach of at most DTHR. For the time variables of
+ * TAUMOD and TCPA, the distance is then at most DTHR+TTHR*vh.
+ */
+double WCV_tvar::horizontalViolationBound(double vh) const {
+  return table.getDTHR()+table.getTTHR()*vh;
+}
+
+double WCV_tvar::verticalViolationBound(double vz) const {
+  return table.getZTHR()+table.getTCOA()*vz;
+}
+
 bool WCV_tvar::conflict(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const {
   return WCV3D(so,vo,si,vi,B,T).conflict();
 }
@@ -210,8 +282,12 @@ void WCV_tvar::setIdentifier(const std::string& s) {
   id = s;
 }
 
+int WCV_tvar::getSuperClassTag() const {
+  return Detection3DRegistry::TAG_WCV_TVAR;
+}
+
 bool WCV_tvar::equals(Detection3D *obj) const {
-  if (!larcfm::equals(getCanonicalClassName(), obj->getCanonicalClassName())) return false;
+  if (getClassTag() != obj->getClassTag()) return false;
   if (!table.equals(((WCV_tvar*)obj)->table)) return false;
   if (!larcfm::equals(id, ((WCV_tvar*)obj)->id)) return false;
   return true;
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Exact representation of kinematic bands, used by the check programs of this directory to compare bands.
+ */
+
+#ifndef BANDS_H_
+#define BANDS_H_
+
+#include "KinematicBands.h"
+#include <cstdio>
+#include <string>
+
+// Value in hexadecimal floating point, so that equal strings mean equal values
+inline std::string exact(double x) {
+  char s[32];
+  std::snprintf(s,sizeof(s),"%a",x);
+  return s;
+}
+
+/**
+ * The track, ground speed, vertical speed, and altitude bands of kb, in internal units, with their regions
+ * and the recovery times, as a string. Two strings are equal if and only if the bands are bit-identical.
+ */
+inline std::string all_bands(larcfm::KinematicBands& kb) {
+  std::string s = "trk";
+  for (int i = 0; i < kb.trackLength(); ++i) {
+    larcfm::Interval ii = kb.track(i,"rad");
+    s += " "+exact(ii.low)+","+exact(ii.up)+":"+larcfm::BandsRegion::to_string(kb.trackRegion(i));
+  }
+  s += " recovery "+exact(kb.trackRecoveryTime())+"\ngs";
+  for (int i = 0; i < kb.groundSpeedLength(); ++i) {
+    larcfm::Interval ii = kb.groundSpeed(i,"m/s");
+    s += " "+exact(ii.low)+","+exact(ii.up)+":"+larcfm::BandsRegion::to_string(kb.groundSpeedRegion(i));
+  }
+  s += " recovery "+exact(kb.groundSpeedRecoveryTime())+"\nvs";
+  for (int i = 0; i < kb.verticalSpeedLength(); ++i) {
+    larcfm::Interval ii = kb.verticalSpeed(i,"m/s");
+    s += " "+exact(ii.low)+","+exact(ii.up)+":"+larcfm::BandsRegion::to_string(kb.verticalSpeedRegion(i));
+  }
+  s += " recovery "+exact(kb.verticalSpeedRecoveryTime())+"\nalt";
+  for (int i = 0; i < kb.altitudeLength(); ++i) {
+    larcfm::Interval ii = kb.altitude(i,"m");
+    s += " "+exact(ii.low)+","+exact(ii.up)+":"+larcfm::BandsRegion::to_string(kb.altitudeRegion(i));
+  }
+  return s+"\n";
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Common code of the check programs of this directory: random values and the count of failed cases.
+ */
+
+#ifndef CHECK_H_
+#define CHECK_H_
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * Failed cases of a check program. A check seeds the random numbers, records each failed case with fail,
+ * and returns the value of result from main. Failures may be recorded from several threads.
+ */
+class Check {
+
+private:
+  std::string name;
+  std::atomic<int> count;
+
+  Check(const Check&);
+  Check& operator=(const Check&);
+
+public:
+  /** Maximum number of failed cases that are printed */
+  static const int PRINTED = 10;
+
+  /**
+   * Construct the check with the given name, and seed the random numbers with seed.
+   */
+  Check(const std::string& name, unsigned seed) : name(name), count(0) {
+    std::srand(seed);
+  }
+
+  /**
+   * Records a failed case. Returns true if the case should be printed, i.e., for the first failed cases.
+   */
+  bool fail() {
+    return count++ < PRINTED;
+  }
+
+  /**
+   * @return number of failed cases.
+   */
+  int failures() const {
+    return count;
+  }
+
+  /**
+   * Prints the name of the check and OK, or FAILED if some case failed. Returns the exit status of the check.
+   */
+  int result() const {
+    std::printf("%s: %s\n",name.c_str(),count == 0 ? "OK" : "FAILED");
+    return count == 0 ? 0 : 1;
+  }
+};
+
+/**
+ * @return random value uniformly distributed in [a,b].
+ */
+inline double uniform(double a, double b) {
+  return a+(b-a)*(std::rand()/(double) RAND_MAX);
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that Daidalus objects used concurrently from several threads give the same results as when they are
+ * used from one thread. Encounters, in Euclidean and geodetic coordinates and with several detectors, are
+ * first computed serially. Then several threads compute them again, each with its own Daidalus objects, while
+ * another thread writes the default parameters (with their current values) and sets the projection type.
+ * Results are the kinematic bands and the time intervals of violation of each aircraft.
+ */
+
+#include "Daidalus.h"
+#include "DefaultDaidalusParameters.h"
+#include "Projection.h"
+#include "CDCylinder.h"
+#include "TCAS3D.h"
+#include "format.h"
+#include "Check.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace larcfm;
+
+/** Ownship and traffic states of an encounter */
+class Encounter {
+public:
+  int detector;
+  std::vector<Position> pos;
+  std::vector<Velocity> vel;
+
+  void random(bool geodetic) {
+    pos.clear();
+    vel.clear();
+    for (int i = 0; i < 6; ++i) {
+      double x = i == 0 ? 0 : uniform(-6,6);
+      double y = i == 0 ? 0 : uniform(-6,6);
+      double alt = 8700+(i == 0 ? 0 : uniform(-1000,1000));
+      pos.push_back(geodetic ? Position::makeLatLonAlt(33.95+x/60,"deg",-96.7+y/60,"deg",alt,"ft") :
+          Position::makeXYZ(x,"nmi",y,"nmi",alt,"ft"));
+      vel.push_back(Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-1000,1000),"fpm"));
+    }
+  }
+
+  // Bands and time intervals of violation, as a string
+  std::string results() const {
+    Daidalus daa;
+    if (detector == 1) {
+      CDCylinder cd;
+      daa.setDetector(&cd);
+    } else if (detector == 2) {
+      TCAS3D cd;
+      daa.setDetector(&cd);
+    }
+    daa.setOwnshipState("Ownship",pos[0],vel[0],0);
+    for (int i = 1; i < (int) pos.size(); ++i) {
+      daa.addTrafficState("AC"+std::to_string(i),pos[i],vel[i]);
+    }
+    std::string s = daa.getKinematicBands().toString();
+    for (int ac = 1; ac < daa.numberOfAircraft(); ++ac) {
+      ConflictData cd = daa.timeIntervalOfViolation(ac);
+      s += FmPrecision(cd.getTimeIn(),8)+" "+FmPrecision(cd.getTimeOut(),8)+"\n";
+    }
+    return s;
+  }
+};
+
+int main(int argc, char* argv[]) {
+  Check check("ConcurrentDaidalus",3);
+  int n = 40;
+  int threads = 4;
+  int rounds = 10;
+  std::vector<Encounter> encounters(n);
+  std::vector<std::string> expected(n);
+  for (int e = 0; e < n; ++e) {
+    encounters[e].detector = e%3;
+    encounters[e].random(e%2 == 1);
+    expected[e] = encounters[e].results();
+  }
+  std::atomic<int> running(threads);
+  std::vector<std::thread> workers;
+  for (int k = 0; k < threads; ++k) {
+    workers.push_back(std::thread([k,n,rounds,&encounters,&expected,&check,&running]() {
+      for (int r = 0; r < rounds; ++r) {
+        for (int j = 0; j < n; ++j) {
+          // Each thread visits the encounters in a different order
+          int e = (j*(2*k+1)+r)%n;
+          if (encounters[e].results() != expected[e] && check.fail()) {
+            std::printf("thread %d, round %d: results of encounter %d differ\n",k,r,e);
+          }
+        }
+      }
+      --running;
+    }));
+  }
+  std::thread writer([&running]() {
+    while (running > 0) {
+      DefaultDaidalusParameters::setLookaheadTime(DefaultDaidalusParameters::getLookaheadTime());
+      DefaultDaidalusParameters::setDTHR(DefaultDaidalusParameters::getDTHR());
+      Projection::setProjectionType(Projection::getProjectionType());
+      std::this_thread::yield();
+    }
+  });
+  for (int k = 0; k < threads; ++k) {
+    workers[k].join();
+  }
+  writer.join();
+  if (Projection::hasMessage() && check.fail()) {
+    std::printf("unexpected message: %s\n",Projection::getMessage().c_str());
+  }
+  Projection::setProjectionType(UNKNOWN_PROJECTION);
+  if (!Projection::hasMessage() && check.fail()) {
+    std::printf("setProjectionType to another type did not add a warning\n");
+  }
+  return check.result();
+}
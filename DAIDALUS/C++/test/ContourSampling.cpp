@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks the regions of ViolationContour against a sampling of the tracks every 0.01 deg, for CDCylinder,
+ * whose regions are computed in closed form, and for WCV_TAUMOD, whose regions are refined by bisection. A
+ * sampled track farther than the track tolerance (0.1 deg) from the bounds of the regions must be in a region
+ * if and only if it is in conflict. Every sampled track of a region must have an entry and an exit position.
+ */
+
+#include "ViolationContour.h"
+#include "CDCylinder.h"
+#include "WCV_TAUMOD.h"
+#include "Check.h"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace larcfm;
+
+// Distance between tracks a and b, modulo 2pi
+static double trk_distance(double a, double b) {
+  double d = std::fmod(std::abs(a-b),2*Pi);
+  return std::min(d,2*Pi-d);
+}
+
+int main(int argc, char* argv[]) {
+  Check check("ContourSampling",10);
+  int encounters = 300;
+  double B = 0;
+  double T = 180;
+  CDCylinder cylinder(Units::from("nmi",1),Units::from("ft",1000));
+  WCV_TAUMOD taumod;
+  const Detection3D* detectors[] = {&cylinder,&taumod};
+  ViolationContour contour;
+  double tol = contour.getTrackTolerance();
+  double step = Units::from("deg",0.01);
+  int regions = 0;
+  for (int e = 0; e < encounters; ++e) {
+    // Aircraft within 5 nmi and 500 ft of the ownship
+    OwnshipState own("Ownship",Position::makeXYZ(0,"nmi",0,"nmi",5000,"ft"),
+        Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(150,250),"knot",uniform(-500,500),"fpm"));
+    TrafficState ac("AC1",Position::makeXYZ(uniform(-5,5),"nmi",uniform(-5,5),"nmi",5000+uniform(-500,500),"ft"),
+        Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-1000,1000),"fpm"));
+    Vect3 si = own.pos_to_s(ac.getPosition());
+    Velocity vi = own.vel_to_v(ac.getPosition(),ac.getVelocity());
+    for (int d = 0; d < 2; ++d) {
+      const Detection3D* detector = detectors[d];
+      contour.compute(detector,own,ac,B,T);
+      regions += contour.size();
+      for (int i = 0; i < contour.size(); ++i) {
+        if ((contour.getEntries(i).size() != contour.getTracks(i).size() ||
+            contour.getExits(i).size() != contour.getTracks(i).size()) && check.fail()) {
+          std::printf("encounter %d, %s, region %d: %d tracks, %d entries, %d exits\n",e,
+              detector->getSimpleClassName().c_str(),i,(int) contour.getTracks(i).size(),
+              (int) contour.getEntries(i).size(),(int) contour.getExits(i).size());
+        }
+      }
+      for (double trk = 0; trk < 2*Pi; trk += step) {
+        bool in = false;
+        bool far = true;
+        for (int i = 0; i < contour.size(); ++i) {
+          Interval ii = contour.getTrackInterval(i);
+          in |= (ii.low <= trk && trk <= ii.up) || (ii.low <= trk+2*Pi && trk+2*Pi <= ii.up);
+          if (ii.up-ii.low < 2*Pi) {
+            far &= trk_distance(trk,ii.low) > tol && trk_distance(trk,ii.up) > tol;
+          }
+        }
+        if (!far) {
+          continue;
+        }
+        Velocity vo = own.vel_to_v(own.getPosition(),own.getVelocity().mkTrk(trk));
+        bool conflict = detector->conflict(own.get_s(),vo,si,vi,B,T);
+        if (in != conflict && check.fail()) {
+          std::printf("encounter %d, %s, track %g deg: in a region %d, in conflict %d\n%s",e,
+              detector->getSimpleClassName().c_str(),Units::to("deg",trk),in,conflict,contour.toString().c_str());
+        }
+      }
+    }
+  }
+  std::printf("%d encounters, %d regions\n",encounters,regions);
+  if (regions == 0 && check.fail()) {
+    std::printf("no regions\n");
+  }
+  return check.result();
+}
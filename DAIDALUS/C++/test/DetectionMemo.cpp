@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that the conflict detection results stored by Daidalus are not reused after a change of the
+ * detector through getDetector, and that the stored results do not grow with the number of query times.
+ * After each change, results must be the same as the ones of a new Daidalus object with the same detector.
+ */
+
+#include "Daidalus.h"
+#include "ConflictDataMemo.h"
+#include "WCV_tvar.h"
+#include "Check.h"
+#include <cstdio>
+#include <vector>
+
+using namespace larcfm;
+
+// Ownship and one aircraft that passes 2 nmi to the right of the ownship
+static void encounter(Daidalus& daa) {
+  daa.setOwnshipState("Ownship",Position::makeXYZ(0,"nmi",0,"nmi",5000,"ft"),
+      Velocity::makeTrkGsVs(0,"deg",200,"knot",0,"fpm"),0);
+  daa.addTrafficState("AC1",Position::makeXYZ(2,"nmi",8,"nmi",5000,"ft"),
+      Velocity::makeTrkGsVs(180,"deg",200,"knot",0,"fpm"));
+}
+
+int main(int argc, char* argv[]) {
+  Check check("DetectionMemo",1);
+  Daidalus daa;
+  encounter(daa);
+  double before = daa.timeToViolation(1);
+  std::vector<double> dthrs;
+  dthrs.push_back(Units::from("nmi",5));
+  dthrs.push_back(Units::from("nmi",3));
+  dthrs.push_back(Units::from("nmi",0.5));
+  for (int i = 0; i < (int) dthrs.size(); ++i) {
+    ((WCV_tvar*) daa.getDetector())->setDTHR(dthrs[i]);
+    double t = daa.timeToViolation(1);
+    Daidalus fresh;
+    fresh.setDetector(daa.getDetector());
+    encounter(fresh);
+    double expected = fresh.timeToViolation(1);
+    if (t != expected && check.fail()) {
+      std::printf("DTHR %g nmi: time to violation %g, expected %g (%g before the change)\n",
+          Units::to("nmi",dthrs[i]),t,expected,before);
+    }
+    if (i == 0 && expected < 0 && check.fail()) {
+      std::printf("DTHR %g nmi: no violation, the encounter does not test the change of detector\n",
+          Units::to("nmi",dthrs[i]));
+    }
+  }
+  // Results at many query times
+  ConflictDataMemo memo;
+  ConflictData data;
+  for (int k = 0; k < 1000; ++k) {
+    for (int ac = 1; ac <= 3; ++ac) {
+      memo.store(ac,daa.getDetector(),k,0,180,data);
+    }
+  }
+  if (memo.size() != 3 && check.fail()) {
+    std::printf("%d results stored after queries at 1000 times, expected 3\n",memo.size());
+  }
+  if ((!memo.lookup(1,daa.getDetector(),999,0,180,data) || memo.lookup(1,daa.getDetector(),998,0,180,data)) &&
+      check.fail()) {
+    std::printf("lookup does not return the results of the last query time only\n");
+  }
+  return check.result();
+}
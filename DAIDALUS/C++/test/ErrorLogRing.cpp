@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks the access to the messages of an ErrorLog by index: on an empty log, with indices out of bounds, and
+ * after the ring buffer of messages wraps around, is read, and the size limit changes. Then checks messages
+ * with a string argument, which is copied and replaces the placeholder when the log is read, as in the
+ * warnings of Daidalus about the class of its detector.
+ */
+
+#include "ErrorLog.h"
+#include "Daidalus.h"
+#include "CDCylinder.h"
+#include "Check.h"
+#include <cstdio>
+#include <string>
+
+using namespace larcfm;
+
+// Checks that log has the messages of values first..last, in this order
+static void expect(Check& check, const std::string& what, const ErrorLog& log, int first, int last) {
+  int n = last-first+1;
+  if (log.messageCount() != n && check.fail()) {
+    std::printf("%s: %d messages, expected %d\n",what.c_str(),log.messageCount(),n);
+    return;
+  }
+  for (int i = 0; i < n; ++i) {
+    std::string text = "Value "+std::to_string(first+i);
+    if ((log.getText(i) != text || !log.isError(i) || log.getCode(i) != ErrorLog::INVALID_VALUE) && check.fail()) {
+      std::printf("%s: message %d is \"%s\", expected \"%s\"\n",what.c_str(),i,log.getText(i).c_str(),text.c_str());
+    }
+  }
+  if ((log.isError(-1) || log.isError(n) || log.getCode(n) != ErrorLog::UNSPECIFIED || log.getText(n) != "") &&
+      check.fail()) {
+    std::printf("%s: messages out of bounds\n",what.c_str());
+  }
+}
+
+int main(int argc, char* argv[]) {
+  Check check("ErrorLogRing",11);
+  ErrorLog::setSizeLimit(5);
+  ErrorLog log("Log");
+  expect(check,"empty log",log,0,-1);
+  for (int k = 0; k < 12; ++k) {
+    log.addError(ErrorLog::INVALID_VALUE,"Value %",k);
+  }
+  expect(check,"12 messages",log,7,11);
+  log.getMessage();
+  expect(check,"read log",log,0,-1);
+  for (int k = 0; k < 7; ++k) {
+    log.addError(ErrorLog::INVALID_VALUE,"Value %",k);
+  }
+  ErrorLog::setSizeLimit(3);
+  log.addError(ErrorLog::INVALID_VALUE,"Value %",7);
+  expect(check,"smaller limit",log,5,7);
+  ErrorLog::setSizeLimit(4);
+  log.addError(ErrorLog::INVALID_VALUE,"Value %",8);
+  log.addError(ErrorLog::INVALID_VALUE,"Value %",9);
+  expect(check,"larger limit",log,6,9);
+  // String arguments
+  ErrorLog::setSizeLimit(25);
+  ErrorLog slog("Log");
+  std::string name = "WCV_TAUMOD";
+  slog.addWarning(ErrorLog::WRONG_DETECTOR,"getD","Detector % is not an instance of CD3D detector",name);
+  name = "CDCylinder";
+  slog.addError(ErrorLog::NOT_FOUND,"setDetector","Detector % is not registered, % and %",name);
+  std::string text0 = "[getD] Detector WCV_TAUMOD is not an instance of CD3D detector";
+  std::string text1 = "[setDetector] Detector CDCylinder is not registered, % and %";
+  if ((slog.getText(0) != text0 || slog.getText(1) != text1 || slog.isError(0) || !slog.isError(1)) && check.fail()) {
+    std::printf("string arguments: \"%s\" and \"%s\"\n",slog.getText(0).c_str(),slog.getText(1).c_str());
+  }
+  Daidalus daa;
+  CDCylinder cd;
+  daa.getD();
+  daa.setDetector(&cd);
+  daa.getDTHR();
+  std::string messages = daa.getMessage();
+  std::string expected =
+      "Warning in Daidalus: [getD] Detector gov.nasa.larcfm.ACCoRD.WCV_TAUMOD is not an instance of CD3D detector\n"
+      "Warning in Daidalus: [getDTHR] Detector gov.nasa.larcfm.ACCoRD.CDCylinder is not an instance of WCV detector\n";
+  if (messages != expected && check.fail()) {
+    std::printf("Daidalus messages:\n%sexpected:\n%s",messages.c_str(),expected.c_str());
+  }
+  return check.result();
+}
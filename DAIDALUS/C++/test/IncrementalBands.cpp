@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that the bands of a KinematicBands object whose traffic is changed by updateTraffic, removeTraffic,
+ * and addTraffic, which only recompute the bands of the changed aircraft, are the same as the bands of a new
+ * KinematicBands object with the same traffic. After each change, all the bands (track, ground speed,
+ * vertical speed, and altitude, with their recovery times) must be bit-identical. The check is run with and
+ * without recovery bands, and with and without a criteria aircraft.
+ */
+
+#include "KinematicBands.h"
+#include "Bands.h"
+#include "Check.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace larcfm;
+
+// Aircraft within 10 nmi and 1000 ft of the ownship. One in four is within 1 nmi, which may be a loss of
+// separation.
+static TrafficState aircraft(const std::string& id) {
+  double r = std::rand()%4 == 0 ? 1 : 10;
+  return TrafficState(id,Position::makeXYZ(uniform(-r,r),"nmi",uniform(-r,r),"nmi",5000+uniform(-1000,1000),"ft"),
+      Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-1000,1000),"fpm"));
+}
+
+// Sets the options of the given mode: recovery bands (bit 0) and criteria aircraft (bit 1)
+static void configure(KinematicBands& kb, int mode) {
+  kb.setRecoveryBands((mode & 1) != 0);
+  if ((mode & 2) != 0) {
+    kb.setConflictCriteria(true);
+    kb.setRecoveryCriteria(true);
+    kb.setCriteriaAircraft("AC0");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  Check check("IncrementalBands",6);
+  int encounters = 10;
+  int n = 8;
+  int steps = 30;
+  int changes = 0;
+  int mixed = 0;
+  for (int mode = 0; mode < 4; ++mode) {
+    for (int e = 0; e < encounters; ++e) {
+      Position po = Position::makeXYZ(0,"nmi",0,"nmi",5000,"ft");
+      Velocity vo = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(150,250),"knot",0,"fpm");
+      std::vector<TrafficState> traffic;
+      KinematicBands kb;
+      configure(kb,mode);
+      kb.setOwnship("Ownship",po,vo);
+      for (int i = 0; i < n; ++i) {
+        traffic.push_back(aircraft("AC"+std::to_string(i)));
+        kb.addTraffic(traffic[i]);
+      }
+      all_bands(kb);
+      int next = n;
+      for (int s = 0; s < steps; ++s) {
+        int r = std::rand()%4;
+        std::string what;
+        if (r == 0 && !traffic.empty()) {
+          // Removes an aircraft
+          int i = std::rand()%traffic.size();
+          what = "remove "+traffic[i].getId();
+          kb.removeTraffic(traffic[i].getId());
+          traffic.erase(traffic.begin()+i);
+        } else if (r == 1) {
+          // Adds a new aircraft
+          traffic.push_back(aircraft("AC"+std::to_string(next++)));
+          what = "add "+traffic.back().getId();
+          if (s%2 == 0) {
+            kb.addTraffic(traffic.back());
+          } else {
+            kb.updateTraffic(traffic.back());
+          }
+        } else if (!traffic.empty()) {
+          // Updates the state of an aircraft, which may be the criteria aircraft
+          int i = r == 2 ? 0 : std::rand()%traffic.size();
+          traffic[i] = aircraft(traffic[i].getId());
+          what = "update "+traffic[i].getId();
+          kb.updateTraffic(traffic[i]);
+        }
+        KinematicBands fresh;
+        configure(fresh,mode);
+        fresh.setOwnship("Ownship",po,vo);
+        for (int i = 0; i < (int) traffic.size(); ++i) {
+          fresh.addTraffic(traffic[i]);
+        }
+        ++changes;
+        std::string bands = all_bands(kb);
+        std::string expected = all_bands(fresh);
+        mixed += bands.find("<NONE>") != std::string::npos && bands.find("<NEAR>") != std::string::npos;
+        if (bands != expected && check.fail()) {
+          std::printf("mode %d, encounter %d, step %d (%s):\n%sexpected:\n%s",mode,e,s,what.c_str(),
+              bands.c_str(),expected.c_str());
+        }
+      }
+    }
+  }
+  std::printf("%d changes of traffic, %d with both conflict and conflict-free bands\n",changes,mixed);
+  if (mixed == 0 && check.fail()) {
+    std::printf("all the bands are either conflict or conflict-free bands\n");
+  }
+  return check.result();
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks the track, ground speed, and vertical speed bands of instantaneous maneuvers, which are computed
+ * in closed form for cylinders, against the bands computed by checking each step value. The stepped bands
+ * are obtained with a cylinder that is not registered as such, so that the closed form is not used. At every
+ * value farther than one step from the ends of the closed form bands and of the range of the dimension, both
+ * bands must be conflict-free, or both must be conflict bands.
+ */
+
+#include "KinematicBands.h"
+#include "CDCylinder.h"
+#include "Detection3DRegistry.h"
+#include "Check.h"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace larcfm;
+
+// Cylinder whose bands are computed step by step
+class SteppedCylinder : public CDCylinder {
+public:
+  SteppedCylinder(double d, double h) : CDCylinder(d,h) {}
+  virtual SteppedCylinder* copy() const {
+    return new SteppedCylinder(*this);
+  }
+  virtual SteppedCylinder* make() const {
+    return new SteppedCylinder(*this);
+  }
+  virtual int getClassTag() const {
+    return Detection3DRegistry::UNKNOWN;
+  }
+};
+
+// Aircraft within 10 nmi and 1000 ft of the ownship
+static TrafficState aircraft(const std::string& id) {
+  return TrafficState(id,Position::makeXYZ(uniform(-10,10),"nmi",uniform(-10,10),"nmi",5000+uniform(-1000,1000),"ft"),
+      Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-1000,1000),"fpm"));
+}
+
+// Intervals and regions of dimension dim (0 for track, 1 for ground speed, 2 for vertical speed) of kb
+static void bands(KinematicBands& kb, int dim, std::vector<Interval>& intervals, std::vector<bool>& none) {
+  intervals.clear();
+  none.clear();
+  int n = dim == 0 ? kb.trackLength() : dim == 1 ? kb.groundSpeedLength() : kb.verticalSpeedLength();
+  for (int i = 0; i < n; ++i) {
+    intervals.push_back(dim == 0 ? kb.track(i,"rad") : dim == 1 ? kb.groundSpeed(i,"m/s") : kb.verticalSpeed(i,"m/s"));
+    BandsRegion::Region region = dim == 0 ? kb.trackRegion(i) : dim == 1 ? kb.groundSpeedRegion(i) :
+        kb.verticalSpeedRegion(i);
+    none.push_back(region == BandsRegion::NONE);
+  }
+}
+
+// 1 if x is in a conflict-free band, 0 if it is only in conflict bands, -1 if it is in no band
+static int none_at(const std::vector<Interval>& intervals, const std::vector<bool>& none, double x) {
+  int in = -1;
+  for (int i = 0; i < (int) intervals.size(); ++i) {
+    if (intervals[i].low <= x && x <= intervals[i].up) {
+      if (none[i]) {
+        return 1;
+      }
+      in = 0;
+    }
+  }
+  return in;
+}
+
+int main(int argc, char* argv[]) {
+  Check check("InstantaneousBands",9);
+  int encounters = 300;
+  double D = Units::from("nmi",1);
+  double H = Units::from("ft",1000);
+  CDCylinder cylinder(D,H);
+  SteppedCylinder stepped_cylinder(D,H);
+  const char* names[] = {"track","ground speed","vertical speed"};
+  int mixed = 0;
+  for (int e = 0; e < encounters; ++e) {
+    Position po = Position::makeXYZ(0,"nmi",0,"nmi",5000,"ft");
+    Velocity vo = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(150,250),"knot",uniform(-500,500),"fpm");
+    KinematicBands closed;
+    KinematicBands stepped;
+    for (int k = 0; k < 2; ++k) {
+      KinematicBands& kb = k == 0 ? closed : stepped;
+      kb.setCoreDetectionRef(k == 0 ? (Detection3D&) cylinder : (Detection3D&) stepped_cylinder);
+      kb.setAlertingTime(kb.getLookaheadTime());
+      kb.setTurnRate(0);
+      kb.setBankAngle(0);
+      kb.setHorizontalAcceleration(0);
+      kb.setVerticalAcceleration(0);
+      kb.setOwnship("Ownship",po,vo);
+    }
+    int n = 1+std::rand()%4;
+    for (int i = 0; i < n; ++i) {
+      TrafficState ac = aircraft("AC"+std::to_string(i));
+      closed.addTraffic(ac);
+      stepped.addTraffic(ac);
+    }
+    for (int dim = 0; dim < 3; ++dim) {
+      double step = dim == 0 ? closed.getTrackStep() : dim == 1 ? closed.getGroundSpeedStep() :
+          closed.getVerticalSpeedStep();
+      double min = dim == 0 ? 0 : dim == 1 ? closed.getMinGroundSpeed() : closed.getMinVerticalSpeed();
+      double max = dim == 0 ? 2*Pi : dim == 1 ? closed.getMaxGroundSpeed() : closed.getMaxVerticalSpeed();
+      std::vector<Interval> ci, si;
+      std::vector<bool> cn, sn;
+      bands(closed,dim,ci,cn);
+      bands(stepped,dim,si,sn);
+      // Ends of closed form bands, and ends of the range of the dimension except the track 0, which is not an end
+      std::vector<double> ends;
+      for (int i = 0; i < (int) ci.size(); ++i) {
+        ends.push_back(ci[i].low);
+        ends.push_back(ci[i].up);
+      }
+      if (dim > 0) {
+        ends.push_back(min);
+        ends.push_back(max);
+      }
+      bool any_none = false;
+      bool any_conflict = false;
+      for (double x = min; x <= max; x += step/10) {
+        bool far = true;
+        for (int i = 0; i < (int) ends.size() && far; ++i) {
+          // Track ends near 0 and 2 pi are close to each other
+          double d = std::abs(x-ends[i]);
+          far = (dim == 0 ? std::min(d,2*Pi-d) : d) > 1.01*step;
+        }
+        if (!far) {
+          continue;
+        }
+        int c = none_at(ci,cn,x);
+        int s = none_at(si,sn,x);
+        any_none |= c == 1;
+        any_conflict |= c == 0;
+        if ((c < 0 || c != s) && check.fail()) {
+          std::printf("encounter %d, %s %g: closed form %d, stepped %d\n",e,names[dim],x,c,s);
+        }
+      }
+      mixed += any_none && any_conflict;
+    }
+  }
+  std::printf("%d encounters, %d bands with both conflict and conflict-free values\n",encounters,mixed);
+  if (mixed == 0 && check.fail()) {
+    std::printf("all the bands are either conflict or conflict-free bands\n");
+  }
+  return check.result();
+}
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks IntervalSet against the algorithms of its former fixed-size implementation, which are kept here
+ * on a vector of intervals. Random sequences of almost_add, unions, almost_intersect, diff, and sweeps are
+ * applied to both, and the intervals must be bit-identical after each operation. Endpoints are taken on a
+ * grid and perturbed below the precision of the almost inequalities, so that almost equal endpoints are
+ * common. Sets grow beyond the inline buffer of IntervalSet, and copies and moves are checked as well.
+ */
+
+#include "IntervalSet.h"
+#include "Util.h"
+#include "Bands.h"
+#include "Check.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace larcfm;
+
+// Former implementation of IntervalSet
+class Reference {
+public:
+  std::vector<Interval> r;
+
+  int order(double x) const {
+    for (int i = 0; i < (int) r.size(); i++) {
+      if (r[i].in(x)) {
+        return i;
+      }
+      if (x < r[i].low) {
+        return -i-1;
+      }
+    }
+    return -((int) r.size())-1;
+  }
+
+  void insert(int i, const Interval& region) {
+    if (region.isEmpty()) {
+      return;
+    }
+    if (i < 0) {
+      i = 0;
+    }
+    if (i > (int) r.size()) {
+      i = r.size();
+    }
+    r.insert(r.begin()+i,region);
+  }
+
+  void remove(int i, int len) {
+    for (int j = 0; j < len; j++) {
+      if (0 <= i && i < (int) r.size()) {
+        r.erase(r.begin()+i);
+      }
+    }
+  }
+
+  void unions(const Interval& rn) {
+    if (rn.isEmpty()) {
+      return;
+    }
+    int iLow = order(rn.low);
+    int iHigh = order(rn.up);
+    double low, high;
+    int start, end;
+    if (iLow < 0) {
+      low = rn.low;
+      start = -(iLow+1);
+    } else {
+      low = r[iLow].low;
+      start = iLow;
+    }
+    if (iHigh < 0) {
+      high = rn.up;
+      end = -(iHigh+1)-1;
+    } else {
+      high = r[iHigh].up;
+      end = iHigh;
+    }
+    remove(start,end-start+1);
+    insert(start,Interval(low,high));
+  }
+
+  void almost_add(double l, double u) {
+    std::vector<Interval> m = r;
+    r.clear();
+    bool go = false;
+    for (int i = 0; i < (int) m.size(); ++i) {
+      Interval ii = m[i];
+      if (go) {
+        unions(ii);
+      } else if ((Util::almost_leq(ii.low,l,PRECISION_DEFAULT) && Util::almost_leq(l,ii.up,PRECISION_DEFAULT)) ||
+          (Util::almost_leq(l,ii.low,PRECISION_DEFAULT) && Util::almost_leq(ii.low,u,PRECISION_DEFAULT))) {
+        l = std::min(ii.low,l);
+        u = std::max(ii.up,u);
+      } else if (Util::almost_less(u,ii.low,PRECISION_DEFAULT)) {
+        unions(Interval(l,u));
+        unions(ii);
+        go = true;
+      } else {
+        unions(ii);
+      }
+    }
+    if (!go) {
+      unions(Interval(l,u));
+    }
+  }
+
+  void almost_intersect(const std::vector<Interval>& n) {
+    std::vector<Interval> m = r;
+    r.clear();
+    int i = 0;
+    int j = 0;
+    while (i < (int) m.size() && j < (int) n.size()) {
+      Interval ii = m[i];
+      Interval jj = n[j];
+      if (Util::almost_leq(jj.low,ii.low,PRECISION_DEFAULT) && Util::almost_less(ii.low,jj.up,PRECISION_DEFAULT)) {
+        if (Util::almost_leq(ii.up,jj.up,PRECISION_DEFAULT)) {
+          unions(ii);
+          ++i;
+        } else {
+          unions(Interval(ii.low,jj.up));
+          ++j;
+        }
+      } else if (Util::almost_leq(ii.low,jj.low,PRECISION_DEFAULT) &&
+          Util::almost_less(jj.low,ii.up,PRECISION_DEFAULT)) {
+        if (Util::almost_leq(jj.up,ii.up,PRECISION_DEFAULT)) {
+          unions(jj);
+          ++j;
+        } else {
+          unions(Interval(jj.low,ii.up));
+          ++i;
+        }
+      } else if (Util::almost_leq(ii.up,jj.low,PRECISION_DEFAULT)) {
+        ++i;
+      } else if (Util::almost_leq(jj.up,ii.low,PRECISION_DEFAULT)) {
+        ++j;
+      }
+    }
+  }
+
+  void diff(const Interval& rn) {
+    if (rn.isEmpty() || rn.isSingle()) {
+      return;
+    }
+    int iLow = order(rn.low);
+    int iHigh = order(rn.up);
+    if (iLow >= 0 && iLow == iHigh) {
+      double r_iHigh_up = r[iHigh].up;
+      r[iLow] = Interval(r[iLow].low,rn.low);
+      insert(iLow+1,Interval(rn.up,r_iHigh_up));
+      return;
+    }
+    int start, end;
+    if (iLow < 0) {
+      start = -(iLow+1);
+    } else {
+      r[iLow] = Interval(r[iLow].low,rn.low);
+      start = iLow+1;
+    }
+    if (iHigh < 0) {
+      end = -(iHigh+1)-1;
+    } else {
+      r[iHigh] = Interval(rn.up,r[iHigh].up);
+      end = iHigh-1;
+    }
+    remove(start,end-start+1);
+  }
+
+  void sweepSingle(double width) {
+    int i = 0;
+    while (i < (int) r.size()) {
+      if (r[i].isSingle(width)) {
+        remove(i,1);
+      } else {
+        i++;
+      }
+    }
+  }
+
+  void sweepBreaks(double width) {
+    int i = 0;
+    while (i < (int) r.size()-1) {
+      if (r[i].up+width > r[i+1].low) {
+        unions(Interval(r[i].low,r[i+1].up));
+      } else {
+        i++;
+      }
+    }
+  }
+};
+
+// Endpoint on a grid of step 0.5 in [0,range], sometimes perturbed below the precision of almost inequalities
+static double endpoint(double range) {
+  double x = 0.5*(std::rand()%(int) (2*range+1));
+  switch (std::rand()%4) {
+  case 0: return x*(1+1e-15);
+  case 1: return x*(1-1e-15);
+  default: return x;
+  }
+}
+
+static Interval interval(double range, double width) {
+  double l = endpoint(range);
+  return Interval(l,l+endpoint(width));
+}
+
+static std::string intervals(const std::vector<Interval>& v) {
+  std::string s;
+  for (int i = 0; i < (int) v.size(); ++i) {
+    s += "["+exact(v[i].low)+","+exact(v[i].up)+"]";
+  }
+  return s;
+}
+
+static std::string intervals(const IntervalSet& set) {
+  std::string s;
+  for (int i = 0; i < set.size(); ++i) {
+    s += "["+exact(set.getInterval(i).low)+","+exact(set.getInterval(i).up)+"]";
+  }
+  return s;
+}
+
+int main(int argc, char* argv[]) {
+  Check check("IntervalSetParity",3);
+  int sequences = 2000;
+  int steps = 60;
+  int largest = 0;
+  for (int q = 0; q < sequences; ++q) {
+    // Ranges that give sets below and above the inline buffer
+    double range = q%2 == 0 ? 20 : 200;
+    IntervalSet set;
+    Reference ref;
+    for (int s = 0; s < steps; ++s) {
+      std::string op;
+      int r = std::rand()%10;
+      if (r < 4) {
+        Interval ii = interval(range,3);
+        op = "almost_add "+ii.toString();
+        set.almost_add(ii.low,ii.up);
+        ref.almost_add(ii.low,ii.up);
+      } else if (r < 6) {
+        Interval ii = interval(range,3);
+        op = "unions "+ii.toString();
+        set.unions(ii);
+        ref.unions(ii);
+      } else if (r == 6) {
+        Reference other;
+        int k = std::rand()%(int) range;
+        for (int i = 0; i < k; ++i) {
+          Interval ii = interval(range,10);
+          other.almost_add(ii.low,ii.up);
+        }
+        op = "almost_intersect "+intervals(other.r);
+        set.almost_intersect(IntervalSet(other.r));
+        ref.almost_intersect(other.r);
+      } else if (r == 7) {
+        Interval ii = interval(range,2);
+        op = "diff "+ii.toString();
+        set.diff(ii);
+        ref.diff(ii);
+      } else if (r == 8) {
+        op = "sweepSingle";
+        set.sweepSingle(0.5);
+        ref.sweepSingle(0.5);
+      } else {
+        op = "sweepBreaks";
+        set.sweepBreaks(0.5);
+        ref.sweepBreaks(0.5);
+      }
+      std::string expected = intervals(ref.r);
+      largest = std::max(largest,set.size());
+      if (intervals(set) != expected || intervals(set.toVector()) != expected) {
+        if (check.fail()) {
+          std::printf("sequence %d, step %d (%s):\n%s\nexpected:\n%s\n",q,s,op.c_str(),intervals(set).c_str(),
+              expected.c_str());
+        }
+        break;
+      }
+    }
+    // Copies and moves
+    std::string expected = intervals(set);
+    IntervalSet copy(set);
+    IntervalSet assigned;
+    assigned.almost_add(0,1);
+    assigned = copy;
+    IntervalSet moved(std::move(copy));
+    IntervalSet swapped;
+    swapped.swap(moved);
+    if ((intervals(assigned) != expected || intervals(swapped) != expected || !moved.isEmpty()) && check.fail()) {
+      std::printf("sequence %d: copy %s, swap %s, expected %s\n",q,intervals(assigned).c_str(),
+          intervals(swapped).c_str(),expected.c_str());
+    }
+  }
+  std::printf("%d sequences, up to %d intervals\n",sequences,largest);
+  if (largest <= IntervalSet::inline_intervals && check.fail()) {
+    std::printf("the sets do not grow beyond the inline buffer\n");
+  }
+  return check.result();
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that the results of Daidalus::getResults and getAllResults, sequentially and with a thread pool,
+ * are the same as the alerts and bands computed by a copy of the Daidalus object after resetOwnship(i), for
+ * each aircraft i. All the aircraft states are given at the same time. Bands must be bit-identical. The
+ * check is run with and without recovery bands, and with and without wind.
+ */
+
+#include "Daidalus.h"
+#include "ThreadPool.h"
+#include "Bands.h"
+#include "Check.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace larcfm;
+
+// Aircraft within 10 nmi and 1000 ft of the origin. One in four is within 1 nmi.
+static TrafficState aircraft(const std::string& id) {
+  double r = std::rand()%4 == 0 ? 1 : 10;
+  return TrafficState(id,Position::makeXYZ(uniform(-r,r),"nmi",uniform(-r,r),"nmi",5000+uniform(-1000,1000),"ft"),
+      Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-1000,1000),"fpm"));
+}
+
+// Alerts, with respect to the indices of the aircraft list of daa, and bands of aircraft i as ownship,
+// computed after resetOwnship(i). The number of alerts is added to alerts.
+static std::string reset_ownship(const Daidalus& daa, int i, int& alerts) {
+  Daidalus dda(daa);
+  dda.resetOwnship(i);
+  std::string s = dda.getOwnshipState().getId()+" alerts";
+  for (int j = 0; j < daa.numberOfAircraft(); ++j) {
+    // Ownship and aircraft i are exchanged in dda
+    int ac = j == 0 ? i : j == i ? 0 : j;
+    int alert = ac > 0 ? dda.alerting(ac) : -1;
+    alerts += alert > 0;
+    s += " "+std::to_string(alert);
+  }
+  KinematicBands bands = dda.getKinematicBands();
+  return s+"\n"+all_bands(bands);
+}
+
+// Alerts and bands of result
+static std::string results(const Daidalus& daa, DaidalusResult& result) {
+  std::string s = result.ownshipId()+" alerts";
+  for (int j = 0; j < daa.numberOfAircraft(); ++j) {
+    s += " "+std::to_string(result.alerting(j));
+  }
+  return s+"\n"+all_bands(result.getKinematicBands());
+}
+
+int main(int argc, char* argv[]) {
+  Check check("OwnshipResults",8);
+  ThreadPool pool(3);
+  int encounters = 5;
+  int n = 10;
+  int alerts = 0;
+  for (int mode = 0; mode < 4; ++mode) {
+    for (int e = 0; e < encounters; ++e) {
+      Daidalus daa;
+      daa.setRecoveryBands((mode & 1) != 0);
+      if ((mode & 2) != 0) {
+        daa.setWindField(Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(0,40),"knot",0,"fpm"));
+      }
+      daa.setOwnshipState(aircraft("AC0"),0);
+      for (int i = 1; i < n; ++i) {
+        daa.addTrafficState(aircraft("AC"+std::to_string(i)));
+      }
+      std::vector<std::string> expected;
+      for (int i = 0; i < n; ++i) {
+        expected.push_back(reset_ownship(daa,i,alerts));
+      }
+      // Every aircraft, and a subset of the aircraft in another order
+      std::vector<int> subset;
+      subset.push_back(n-1);
+      subset.push_back(0);
+      subset.push_back(n/2);
+      for (int p = 0; p < 2; ++p) {
+        ThreadPool* tp = p == 0 ? NULL : &pool;
+        std::vector<DaidalusResult> all = daa.getAllResults(tp);
+        std::vector<DaidalusResult> some = daa.getResults(subset,tp);
+        if (all.size() != (std::size_t) n || some.size() != subset.size()) {
+          if (check.fail()) {
+            std::printf("mode %d, encounter %d, pool %d: %d and %d results, expected %d and %d\n",mode,e,p,
+                (int) all.size(),(int) some.size(),n,(int) subset.size());
+          }
+          continue;
+        }
+        for (int k = 0; k < n+(int) subset.size(); ++k) {
+          int i = k < n ? k : subset[k-n];
+          DaidalusResult& result = k < n ? all[k] : some[k-n];
+          std::string s = results(daa,result);
+          if ((result.ownshipIndex() != i || s != expected[i]) && check.fail()) {
+            std::printf("mode %d, encounter %d, pool %d, aircraft %d (result of index %d):\n%sexpected:\n%s",
+                mode,e,p,i,result.ownshipIndex(),s.c_str(),expected[i].c_str());
+          }
+        }
+      }
+    }
+  }
+  std::printf("%d ownships, %d alerts\n",4*encounters*n,alerts);
+  if (alerts == 0 && check.fail()) {
+    std::printf("no alerts\n");
+  }
+  return check.result();
+}
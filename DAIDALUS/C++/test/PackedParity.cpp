@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that the functions of Packed give, lane by lane, the same results as their scalar counterparts, on
+ * random values that include zeros and values close to zero. Functions are checked with 2, 4, and 8 lanes,
+ * and through packed_run, which runs them with the instruction set selected at run time (see packed_lanes).
+ * The batched functions of WCV_Vertical, which use packed_run, are checked against the scalar functions,
+ * including the aircraft that do not fill a packed value. Results must be identical, not almost equal.
+ */
+
+#include "Packed.h"
+#include "Horizontal.h"
+#include "WCV_Vertical.h"
+#include "Vect2.h"
+#include "Util.h"
+#include "Check.h"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace larcfm;
+
+#if DAIDALUS_PACKED
+
+// Packed values do not cross function calls, since the functions of Packed are inlined (see Packed.h)
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// Failed cases of the check
+static Check* parity;
+
+// Random value in [a,b], 0, or a value close to 0
+static double value(double a, double b) {
+  int r = std::rand()%10;
+  if (r == 0) {
+    return 0;
+  }
+  if (r == 1) {
+    return 1E-14*uniform(-1,1);
+  }
+  return uniform(a,b);
+}
+
+// True if a and b are the same number or both NaN
+static bool same(double a, double b) {
+  return a == b || (a != a && b != b);
+}
+
+static void check(bool ok, const char* what, int lanes) {
+  if (!ok && parity->fail()) {
+    std::printf("%s differs with %d lanes\n",what,lanes);
+  }
+}
+
+/** Random inputs of 8 aircraft */
+class Inputs {
+public:
+  double sx[8], sy[8], sz[8], vx[8], vy[8], vz[8];
+  double B, T, ZTHR, TCOA;
+
+  void random() {
+    for (int j = 0; j < 8; ++j) {
+      sx[j] = value(-1E4,1E4);
+      sy[j] = value(-1E4,1E4);
+      sz[j] = value(-2000,2000);
+      vx[j] = value(-300,300);
+      vy[j] = value(-300,300);
+      vz[j] = value(-50,50);
+    }
+    B = uniform(0,10);
+    T = B+uniform(0,100);
+    ZTHR = uniform(100,500);
+    TCOA = uniform(0,30);
+  }
+};
+
+/** Compares the first N lanes of Packed<N> with the scalar functions, as a functor of packed_run */
+class Lanes {
+public:
+  const Inputs* in;
+  int lanes;
+
+  template <int N>
+  DAIDALUS_PACKED_INLINE void run() {
+    typedef Packed<N> P;
+    lanes = N;
+    typename P::vec sx = P::load(in->sx);
+    typename P::vec sy = P::load(in->sy);
+    typename P::vec sz = P::load(in->sz);
+    typename P::vec vx = P::load(in->vx);
+    typename P::vec vy = P::load(in->vy);
+    typename P::vec vz = P::load(in->vz);
+    typename P::vec tcpa = P::tcpa(sx,sy,vx,vy);
+    typename P::vec dcpa = P::dcpa(sx,sy,vx,vy);
+    typename P::vec norm = P::norm(sx,sy);
+    typename P::vec dot2 = P::dot(sx,sy,vx,vy);
+    typename P::vec dot3 = P::dot(sx,sy,sz,vx,vy,vz);
+    typename P::vec scaladd = P::scalAdd(sz,vx,sx);
+    typename P::mask vwcv = P::vertical_WCV(in->ZTHR,in->TCOA,sz,vz);
+    typename P::vec time_in, time_out;
+    P::vertical_WCV_interval(in->ZTHR,in->TCOA,in->B,in->T,sz,vz,time_in,time_out);
+    for (int j = 0; j < N; ++j) {
+      Vect2 s(in->sx[j],in->sy[j]);
+      Vect2 v(in->vx[j],in->vy[j]);
+      Vect3 s3(in->sx[j],in->sy[j],in->sz[j]);
+      Vect3 v3(in->vx[j],in->vy[j],in->vz[j]);
+      WCV_Vertical vertical;
+      vertical.vertical_WCV_interval(in->ZTHR,in->TCOA,in->B,in->T,in->sz[j],in->vz[j]);
+      check(same(tcpa[j],Horizontal::tcpa(s,v)),"tcpa",N);
+      check(same(dcpa[j],Horizontal::dcpa(s,v)),"dcpa",N);
+      check(same(norm[j],s.norm()),"norm",N);
+      check(same(dot2[j],s.dot(v)),"dot (Vect2)",N);
+      check(same(dot3[j],s3.dot(v3)),"dot (Vect3)",N);
+      check(same(scaladd[j],v.ScalAdd(in->sz[j],s).x),"scalAdd",N);
+      check((vwcv[j] != 0) == WCV_Vertical::vertical_WCV(in->ZTHR,in->TCOA,in->sz[j],in->vz[j]),"vertical_WCV",N);
+      check(same(time_in[j],vertical.time_in) && same(time_out[j],vertical.time_out),"vertical_WCV_interval",N);
+    }
+  }
+};
+
+// Batched functions of WCV_Vertical on n aircraft, against the scalar functions
+static void check_blocks(const Inputs& in, int n) {
+  double z = uniform(-10,10);
+  double wz = uniform(-10,10);
+  double t = uniform(0,5);
+  char keep[8];
+  WCV_Vertical::vertical_WCV_block(keep,n,in.ZTHR,in.TCOA,z,wz,t,in.sz,in.vz);
+  for (int j = 0; j < n; ++j) {
+    check((keep[j] != 0) == WCV_Vertical::vertical_WCV(in.ZTHR,in.TCOA,z-(t*in.vz[j]+in.sz[j]),wz-in.vz[j]),
+        "vertical_WCV_block",packed_lanes());
+  }
+  char before[8];
+  for (int j = 0; j < n; ++j) {
+    before[j] = keep[j] = std::rand()%4 != 0;
+  }
+  WCV_Vertical::vertical_WCV_interval_block(keep,n,in.ZTHR,in.TCOA,in.B,in.T,z,wz,t,in.sz,in.vz);
+  for (int j = 0; j < n; ++j) {
+    WCV_Vertical vertical;
+    vertical.vertical_WCV_interval(in.ZTHR,in.TCOA,in.B,in.T,z-(t*in.vz[j]+in.sz[j]),wz-in.vz[j]);
+    bool expected = before[j] && !(vertical.time_in > vertical.time_out);
+    check((keep[j] != 0) == expected,"vertical_WCV_interval_block",packed_lanes());
+  }
+}
+
+int main(int argc, char* argv[]) {
+  Check result("PackedParity ("+std::to_string(packed_lanes())+" lanes)",5);
+  parity = &result;
+#if DAIDALUS_PACKED_X86
+  __builtin_cpu_init();
+  int expected = __builtin_cpu_supports("avx2") ? 4 : 2;
+  check(packed_lanes() == expected,"packed_lanes",packed_lanes());
+#endif
+  int cases = 100000;
+  Inputs in;
+  for (int i = 0; i < cases; ++i) {
+    in.random();
+    Lanes lanes = {&in,0};
+    lanes.run<2>();
+    lanes.run<4>();
+    lanes.run<8>();
+    packed_run(lanes);
+    check(lanes.lanes == packed_lanes(),"packed_run",lanes.lanes);
+    check_blocks(in,1+i%8);
+  }
+  return result.result();
+}
+
+#else
+
+int main(int argc, char* argv[]) {
+  std::printf("PackedParity: OK (Packed is not supported by this compiler)\n");
+  return 0;
+}
+
+#endif
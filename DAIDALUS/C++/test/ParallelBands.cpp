@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that the bands computed by computeAllBands with a thread pool are bit-identical to the bands
+ * computed sequentially. Encounters have more aircraft than the threads of the pool, and are checked with
+ * and without recovery bands and a criteria aircraft. After the first computation, the state of one
+ * aircraft is changed, so that the bands of the changed aircraft only are computed again by the pool.
+ */
+
+#include "KinematicBands.h"
+#include "ThreadPool.h"
+#include "Bands.h"
+#include "Check.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace larcfm;
+
+// Aircraft within 10 nmi and 1000 ft of the ownship. One in four is within 1 nmi, which may be a loss of
+// separation.
+static TrafficState aircraft(const std::string& id) {
+  double r = std::rand()%4 == 0 ? 1 : 10;
+  return TrafficState(id,Position::makeXYZ(uniform(-r,r),"nmi",uniform(-r,r),"nmi",5000+uniform(-1000,1000),"ft"),
+      Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-1000,1000),"fpm"));
+}
+
+// Sets the options of the given mode: recovery bands (bit 0) and criteria aircraft (bit 1)
+static void configure(KinematicBands& kb, int mode) {
+  kb.setRecoveryBands((mode & 1) != 0);
+  if ((mode & 2) != 0) {
+    kb.setConflictCriteria(true);
+    kb.setRecoveryCriteria(true);
+    kb.setCriteriaAircraft("AC0");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  Check check("ParallelBands",4);
+  ThreadPool pool(3);
+  int encounters = 10;
+  int n = 20;
+  int mixed = 0;
+  for (int mode = 0; mode < 4; ++mode) {
+    for (int e = 0; e < encounters; ++e) {
+      Position po = Position::makeXYZ(0,"nmi",0,"nmi",5000,"ft");
+      Velocity vo = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(150,250),"knot",0,"fpm");
+      KinematicBands parallel;
+      KinematicBands serial;
+      configure(parallel,mode);
+      configure(serial,mode);
+      parallel.setThreadPool(&pool);
+      parallel.setOwnship("Ownship",po,vo);
+      serial.setOwnship("Ownship",po,vo);
+      for (int i = 0; i < n; ++i) {
+        TrafficState ac = aircraft("AC"+std::to_string(i));
+        parallel.addTraffic(ac);
+        serial.addTraffic(ac);
+      }
+      for (int s = 0; s < 2; ++s) {
+        if (s == 1) {
+          // Changes the state of one aircraft, which may be the criteria aircraft
+          TrafficState ac = aircraft("AC"+std::to_string(std::rand()%2 == 0 ? 0 : std::rand()%n));
+          parallel.updateTraffic(ac);
+          serial.updateTraffic(ac);
+        }
+        parallel.computeAllBands();
+        serial.computeAllBands();
+        std::string bands = all_bands(parallel);
+        std::string expected = all_bands(serial);
+        mixed += bands.find("<NONE>") != std::string::npos && bands.find("<NEAR>") != std::string::npos;
+        if (bands != expected && check.fail()) {
+          std::printf("mode %d, encounter %d, step %d:\n%sexpected:\n%s",mode,e,s,bands.c_str(),
+              expected.c_str());
+        }
+      }
+    }
+  }
+  std::printf("%d computations of bands for %d aircraft, %d with both conflict and conflict-free bands\n",
+      8*encounters,n,mixed);
+  if (mixed == 0 && check.fail()) {
+    std::printf("all the bands are either conflict or conflict-free bands\n");
+  }
+  return check.result();
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that probeVelocities gives, for each candidate velocity, the same results as conflict detection on
+ * each aircraft, when the ownship flies the candidate velocity. The reference result of a candidate is
+ * computed by a copy of the Daidalus object, where the ownship state is set with the candidate velocity and
+ * the traffic states are added again. Encounters use several detectors, Euclidean and geodetic coordinates,
+ * and a wind field or no wind. Candidates are probed serially and with a thread pool.
+ */
+
+#include "Daidalus.h"
+#include "CDCylinder.h"
+#include "TCAS3D.h"
+#include "WCV_TCPA.h"
+#include "Check.h"
+#include <cstdio>
+#include <vector>
+
+using namespace larcfm;
+
+// Conflicts of the ownship of daa with each aircraft, for lookahead time
+static ProbeResult reference(const Daidalus& daa) {
+  ProbeResult result;
+  OwnshipState own = daa.getOwnshipState();
+  Velocity vo = own.vel_to_v(own.getPosition(),own.getVelocity());
+  for (int ac = 1; ac < daa.numberOfAircraft(); ++ac) {
+    TrafficState intruder = daa.getTrafficState(ac);
+    Position pi = intruder.getPosition();
+    ConflictData cd = daa.getDetector()->conflictDetection(own.get_s(),vo,own.pos_to_s(pi),
+        own.vel_to_v(pi,intruder.getVelocity()),0,daa.getLookaheadTime());
+    if (cd.conflict()) {
+      result.add(ac,cd.getTimeIn());
+    }
+  }
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  int trials = 16;
+  int n = 50;
+  int candidates = 200;
+  Check check("ProbeParity",0);
+  int conflicts = 0;
+  ThreadPool pool(3);
+  for (int trial = 0; trial < trials; ++trial) {
+    std::srand(trial);
+    Daidalus daa;
+    if (trial%4 == 1) {
+      CDCylinder cd;
+      daa.setDetector(&cd);
+    } else if (trial%4 == 2) {
+      TCAS3D cd;
+      daa.setDetector(&cd);
+    } else if (trial%4 == 3) {
+      WCV_TCPA cd;
+      daa.setDetector(&cd);
+    }
+    bool geodetic = trial%2 == 1;
+    bool wind = (trial/2)%2 == 1;
+    if (wind) {
+      daa.setWindField(Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(20,60),"knot",0,"fpm"));
+    }
+    Position po = geodetic ? Position::makeLatLonAlt(33.95,"deg",-96.7,"deg",8700,"ft") :
+        Position::makeXYZ(0,"nmi",0,"nmi",8700,"ft");
+    Velocity vo = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-500,500),"fpm");
+    std::vector<std::string> ids;
+    std::vector<Position> pos;
+    std::vector<Velocity> vel;
+    for (int i = 0; i < n; ++i) {
+      ids.push_back("AC"+std::to_string(i));
+      pos.push_back(geodetic ?
+          Position::makeLatLonAlt(33.95+uniform(-0.2,0.2),"deg",-96.7+uniform(-0.2,0.2),"deg",8700+uniform(-3000,3000),"ft") :
+          Position::makeXYZ(uniform(-12,12),"nmi",uniform(-12,12),"nmi",8700+uniform(-3000,3000),"ft"));
+      vel.push_back(Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,400),"knot",uniform(-1500,1500),"fpm"));
+    }
+    daa.setOwnshipState("Ownship",po,vo,0);
+    for (int i = 0; i < n; ++i) {
+      daa.addTrafficState(ids[i],pos[i],vel[i]);
+    }
+    std::vector<Velocity> velocities;
+    for (int k = 0; k < candidates; ++k) {
+      velocities.push_back(Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,400),"knot",uniform(-2000,2000),"fpm"));
+    }
+    std::vector<ProbeResult> serial;
+    std::vector<ProbeResult> parallel;
+    daa.probeVelocities(velocities,serial,NULL);
+    daa.probeVelocities(velocities,parallel,&pool);
+    for (int k = 0; k < candidates; ++k) {
+      Daidalus candidate(daa);
+      candidate.setOwnshipState("Ownship",po,velocities[k],0);
+      for (int i = 0; i < n; ++i) {
+        candidate.addTrafficState(ids[i],pos[i],vel[i]);
+      }
+      ProbeResult expected = reference(candidate);
+      conflicts += expected.conflict();
+      for (int p = 0; p < 2; ++p) {
+        const ProbeResult& result = p == 0 ? serial[k] : parallel[k];
+        if ((result.getAircraft() != expected.getAircraft() || result.getTimeIn() != expected.getTimeIn()) &&
+            check.fail()) {
+          std::printf("trial %d (%s, %s), candidate %d, %s: %d aircraft from %g, expected %d aircraft from %g\n",
+              trial,geodetic ? "geodetic" : "Euclidean",wind ? "wind" : "no wind",k,p == 0 ? "serial" : "pool",
+              (int) result.getAircraft().size(),result.getTimeIn(),
+              (int) expected.getAircraft().size(),expected.getTimeIn());
+        }
+      }
+    }
+  }
+  std::printf("%d/%d candidates in conflict\n",conflicts,trials*candidates);
+  return check.result();
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks the recovery bands when the minimum recovery separation is within the NMAC cylinder (300 ft and
+ * 80 ft). Then, there is no recovery cylinder to search, and the bands of an ownship in loss of separation
+ * are the ones that avoid the NMAC cylinder: they must be the same as the conflict bands computed with the
+ * NMAC cylinder as detector. Track, ground speed, and vertical speed bands are checked.
+ */
+
+#include "KinematicBands.h"
+#include "CDCylinder.h"
+#include "ACCoRDConfig.h"
+#include "Check.h"
+#include <cstdio>
+#include <string>
+
+using namespace larcfm;
+
+// Intervals of the bands of kb whose region is NONE
+static std::string none(KinematicBands& kb) {
+  std::string s;
+  for (int i = 0; i < kb.trackLength(); ++i) {
+    if (kb.trackRegion(i) == BandsRegion::NONE) {
+      s += "trk "+kb.track(i,"deg").toString()+" ";
+    }
+  }
+  for (int i = 0; i < kb.groundSpeedLength(); ++i) {
+    if (kb.groundSpeedRegion(i) == BandsRegion::NONE) {
+      s += "gs "+kb.groundSpeed(i,"kn").toString()+" ";
+    }
+  }
+  for (int i = 0; i < kb.verticalSpeedLength(); ++i) {
+    if (kb.verticalSpeedRegion(i) == BandsRegion::NONE) {
+      s += "vs "+kb.verticalSpeed(i,"fpm").toString()+" ";
+    }
+  }
+  return s;
+}
+
+int main(int argc, char* argv[]) {
+  Check check("RecoveryBands",2);
+  int cases = 300;
+  int green = 0;
+  CDCylinder nmac = CDCylinder::mk(ACCoRDConfig::NMAC_D,ACCoRDConfig::NMAC_H);
+  for (int e = 0; e < cases; ++e) {
+    // Aircraft within 0.6 nmi and 300 ft of the ownship
+    Position po = Position::makeXYZ(0,"nmi",0,"nmi",5000,"ft");
+    Velocity vo = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(150,250),"knot",0,"fpm");
+    Position pi = Position::makeXYZ(uniform(-0.6,0.6),"nmi",uniform(-0.6,0.6),"nmi",5000+uniform(-300,300),"ft");
+    Velocity vi = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(150,250),"knot",0,"fpm");
+    KinematicBands kb;
+    kb.setRecoveryBands(true);
+    kb.setMinHorizontalRecovery(300,"ft");
+    kb.setMinVerticalRecovery(80,"ft");
+    kb.setOwnship("Ownship",po,vo);
+    kb.addTraffic("AC1",pi,vi);
+    KinematicBands ref;
+    ref.setCoreDetectionRef(nmac);
+    ref.setLookaheadTime(kb.getLookaheadTime());
+    ref.setAlertingTime(kb.getLookaheadTime());
+    ref.setOwnship("Ownship",po,vo);
+    ref.addTraffic("AC1",pi,vi);
+    std::string bands = none(kb);
+    std::string expected = none(ref);
+    green += bands != "";
+    if (bands != expected && check.fail()) {
+      std::printf("encounter %d: %s\nexpected: %s\n",e,bands.c_str(),expected.c_str());
+    }
+  }
+  std::printf("%d/%d encounters with bands that avoid the NMAC cylinder\n",green,cases);
+  if (green == 0 && check.fail()) {
+    std::printf("all the encounters are solid red\n");
+  }
+  return check.result();
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that recomputing kinematic bands does not allocate memory once the scratch storage of the bands
+ * is large enough (see KinematicRealBands.h). A sequence of encounters is computed twice by the same
+ * KinematicBands object. The first pass sizes the scratch storage. The second pass counts the calls to
+ * operator new, which should be 0.
+ */
+
+#include "KinematicBands.h"
+#include "Check.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace larcfm;
+
+static long allocations = 0;
+static bool counting = false;
+
+void* operator new(std::size_t n) {
+  if (counting) {
+    ++allocations;
+  }
+  void* p = std::malloc(n > 0 ? n : 1);
+  if (p == NULL) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+// Computes the bands of the ownship and the traffic at time t, returns the number of band intervals
+static int bands(KinematicBands& kb, const Velocity& vo, const std::vector<std::string>& ids,
+    const std::vector<Position>& pos, const std::vector<Velocity>& vel, double t) {
+  kb.clear();
+  kb.setOwnship("Ownship",Position::mkXYZ(0,0,1524).linear(vo,t),vo);
+  for (int i = 0; i < (int) ids.size(); ++i) {
+    kb.addTraffic(ids[i],pos[i].linear(vel[i],t),vel[i]);
+  }
+  return kb.trackLength()+kb.groundSpeedLength()+kb.verticalSpeedLength()+kb.altitudeLength();
+}
+
+int main(int argc, char* argv[]) {
+  Check check("ScratchAllocations",1);
+  int n = 20;
+  int cycles = 20;
+  Velocity vo = Velocity::makeTrkGsVs(0,"deg",200,"knot",0,"fpm");
+  std::vector<std::string> ids;
+  std::vector<Position> pos;
+  std::vector<Velocity> vel;
+  for (int i = 0; i < n; ++i) {
+    ids.push_back("AC"+std::to_string(i));
+    // Aircraft within 5 nmi and 1000 ft of the ownship, some of them in conflict or in loss of separation
+    pos.push_back(Position::mkXYZ(uniform(-9260,9260),uniform(-9260,9260),uniform(1220,1830)));
+    vel.push_back(Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-1000,1000),"fpm"));
+  }
+  KinematicBands kb;
+  kb.setRecoveryBands(true);
+  std::vector<int> sizes;
+  for (int c = 0; c < cycles; ++c) {
+    sizes.push_back(bands(kb,vo,ids,pos,vel,c));
+  }
+  for (int c = 0; c < cycles; ++c) {
+    counting = true;
+    long before = allocations;
+    int size = bands(kb,vo,ids,pos,vel,c);
+    counting = false;
+    if ((allocations > before || size != sizes[c]) && check.fail()) {
+      std::printf("cycle %d: %ld allocations, %d band intervals (%d expected)\n",c,allocations-before,size,sizes[c]);
+    }
+  }
+  return check.result();
+}
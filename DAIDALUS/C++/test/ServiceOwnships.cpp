@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks the removal of the ownships of a DaidalusService, with 0 and 4 workers: an ownship is removed at once
+ * when it has no pending jobs, and after its pending jobs otherwise. Jobs submitted after the removal of their
+ * ownship must still be processed, in order, and give the same results as a copy of the Daidalus object of the
+ * service. The Daidalus objects of these jobs log no messages, so neither does the service.
+ */
+
+#include "DaidalusService.h"
+#include "format.h"
+#include "Check.h"
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace larcfm;
+
+// Alerts and bands of a result, as a string
+static std::string results(const DaidalusJob& job, DaidalusResult& result) {
+  std::string s = result.ownshipId()+" "+FmPrecision(job.getTime());
+  for (int ac = 1; ac <= (int) job.getTraffic().size(); ++ac) {
+    s += " "+Fm0(result.alerting(ac));
+  }
+  return s+"\n"+result.getKinematicBands().toString();
+}
+
+// Alerts and bands of a job computed by a copy of prototype
+static std::string direct(const Daidalus& prototype, const DaidalusJob& job) {
+  Daidalus daa(prototype);
+  daa.setOwnshipState(job.getOwnship(),job.getTime());
+  for (int i = 0; i < (int) job.getTraffic().size(); ++i) {
+    daa.addTrafficState(job.getTraffic()[i]);
+  }
+  std::vector<int> alerts(job.getTraffic().size()+1,-1);
+  for (int ac = 1; ac < (int) alerts.size(); ++ac) {
+    alerts[ac] = daa.alerting(ac);
+  }
+  KinematicBands bands = daa.getKinematicBands();
+  bands.computeAllBands();
+  DaidalusResult result(0,job.ownshipId(),alerts,bands);
+  return results(job,result);
+}
+
+static DaidalusJob random_job(int o, int step, int n) {
+  Position po = Position::makeLatLonAlt(33.95,"deg",-96.7+o*0.5,"deg",8700,"ft");
+  Velocity vo = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,250),"knot",0,"fpm");
+  DaidalusJob job(TrafficState("Ownship"+std::to_string(o),po,vo),step);
+  for (int i = 0; i < n; ++i) {
+    Position pi = Position::makeLatLonAlt(33.95+uniform(-0.08,0.08),"deg",-96.7+o*0.5+uniform(-0.08,0.08),"deg",
+        8700+uniform(-800,800),"ft");
+    Velocity vi = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-500,500),"fpm");
+    job.addTraffic(TrafficState("AC"+std::to_string(i),pi,vi));
+  }
+  return job;
+}
+
+int main(int argc, char* argv[]) {
+  Check check("ServiceOwnships",23);
+  int ownships = 8;
+  int steps = 6;
+  Daidalus prototype;
+  prototype.setWindField(Velocity::makeTrkGsVs(45,"deg",60,"knot",0,"fpm"));
+  // Ownships are removed after steps 1 and 3, ownships 0..3 are resubmitted before they are processed
+  std::vector<std::vector<DaidalusJob> > jobs(steps);
+  for (int step = 0; step < steps; ++step) {
+    for (int o = 0; o < ownships; ++o) {
+      jobs[step].push_back(random_job(o,step,5));
+    }
+  }
+  int workers[] = {0,4};
+  for (int w = 0; w < 2; ++w) {
+    std::mutex mutex;
+    std::map<std::string,std::vector<std::string> > delivered;
+    DaidalusService service(prototype,workers[w],
+        [&mutex,&delivered](const DaidalusJob& job, DaidalusResult& result, const DaidalusJobStats& stats) {
+      std::lock_guard<std::mutex> lock(mutex);
+      delivered[job.ownshipId()].push_back(results(job,result));
+    });
+    for (int step = 0; step < steps; ++step) {
+      for (int o = 0; o < ownships; ++o) {
+        service.submit(jobs[step][o]);
+      }
+      if (step == 1 || step == 3) {
+        for (int o = 0; o < ownships; ++o) {
+          std::string id = jobs[step][o].ownshipId();
+          if (!service.removeOwnship(id) && check.fail()) {
+            std::printf("%d workers: %s not removed after step %d\n",workers[w],id.c_str(),step);
+          }
+          if (service.removeOwnship(id) && check.fail()) {
+            std::printf("%d workers: %s removed twice after step %d\n",workers[w],id.c_str(),step);
+          }
+        }
+      }
+      if (step == 3) {
+        service.wait();
+        if (service.ownshipCount() != 0 && check.fail()) {
+          std::printf("%d workers: %d ownships after their removal\n",workers[w],service.ownshipCount());
+        }
+      }
+    }
+    service.wait();
+    if (service.ownshipCount() != ownships && check.fail()) {
+      std::printf("%d workers: %d ownships, expected %d\n",workers[w],service.ownshipCount(),ownships);
+    }
+    if (service.removeOwnship("Unknown") && check.fail()) {
+      std::printf("%d workers: unknown ownship removed\n",workers[w]);
+    }
+    for (int o = 0; o < ownships; ++o) {
+      const std::vector<std::string>& got = delivered[jobs[0][o].ownshipId()];
+      for (int step = 0; step < steps; ++step) {
+        if ((step >= (int) got.size() || got[step] != direct(prototype,jobs[step][o])) && check.fail()) {
+          std::printf("%d workers: job %d of %s differs from direct computation\n",workers[w],step,
+              jobs[step][o].ownshipId().c_str());
+        }
+      }
+    }
+    if (service.hasMessage() && check.fail()) {
+      std::printf("%d workers: unexpected messages\n%s",workers[w],service.getMessage().c_str());
+    }
+  }
+  return check.result();
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that the jobs processed by a DaidalusService give the same alerts and bands as a copy of the
+ * Daidalus object of the service, used directly. The Daidalus object has a wind field, which must be kept
+ * for every job. Jobs of several ownships are processed with 0, 1, and 4 workers, and the jobs of each
+ * ownship must be delivered in the order they were submitted. Then checks that an exception thrown by the
+ * callback is reported by the service, and that the other jobs are still processed.
+ */
+
+#include "DaidalusService.h"
+#include "format.h"
+#include "Check.h"
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace larcfm;
+
+// Alerts and bands of a result, as a string
+static std::string results(const DaidalusJob& job, DaidalusResult& result) {
+  std::string s = result.ownshipId()+" "+FmPrecision(job.getTime());
+  for (int ac = 1; ac <= (int) job.getTraffic().size(); ++ac) {
+    s += " "+Fm0(result.alerting(ac));
+  }
+  return s+"\n"+result.getKinematicBands().toString();
+}
+
+// Alerts and bands of a job computed by daa
+static std::string direct(const Daidalus& prototype, const DaidalusJob& job) {
+  Daidalus daa(prototype);
+  daa.setOwnshipState(job.getOwnship(),job.getTime());
+  for (int i = 0; i < (int) job.getTraffic().size(); ++i) {
+    daa.addTrafficState(job.getTraffic()[i]);
+  }
+  std::vector<int> alerts(job.getTraffic().size()+1,-1);
+  for (int ac = 1; ac < (int) alerts.size(); ++ac) {
+    alerts[ac] = daa.alerting(ac);
+  }
+  KinematicBands bands = daa.getKinematicBands();
+  bands.computeAllBands();
+  DaidalusResult result(0,job.ownshipId(),alerts,bands);
+  return results(job,result);
+}
+
+int main(int argc, char* argv[]) {
+  Check check("ServiceParity",7);
+  int ownships = 20;
+  int steps = 4;
+  int n = 5;
+  std::vector<DaidalusJob> jobs;
+  for (int step = 0; step < steps; ++step) {
+    for (int o = 0; o < ownships; ++o) {
+      Position po = Position::makeLatLonAlt(33.95,"deg",-96.7+o*0.5,"deg",8700,"ft");
+      Velocity vo = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,250),"knot",0,"fpm");
+      DaidalusJob job(TrafficState("Ownship"+std::to_string(o),po,vo),step);
+      for (int i = 0; i < n; ++i) {
+        Position pi = Position::makeLatLonAlt(33.95+uniform(-0.08,0.08),"deg",-96.7+o*0.5+uniform(-0.08,0.08),"deg",
+            8700+uniform(-800,800),"ft");
+        Velocity vi = Velocity::makeTrkGsVs(uniform(0,360),"deg",uniform(100,300),"knot",uniform(-500,500),"fpm");
+        job.addTraffic(TrafficState("AC"+std::to_string(i),pi,vi));
+      }
+      jobs.push_back(job);
+    }
+  }
+  Daidalus prototype;
+  prototype.setWindField(Velocity::makeTrkGsVs(45,"deg",60,"knot",0,"fpm"));
+  std::vector<std::string> expected;
+  int windy = 0;
+  for (int k = 0; k < (int) jobs.size(); ++k) {
+    expected.push_back(direct(prototype,jobs[k]));
+    windy += expected[k] != direct(Daidalus(),jobs[k]);
+  }
+  int workers[] = {0,1,4};
+  for (int w = 0; w < 3; ++w) {
+    std::mutex mutex;
+    std::map<std::string,std::vector<std::string> > delivered;
+    {
+      DaidalusService service(prototype,workers[w],
+          [&mutex,&delivered](const DaidalusJob& job, DaidalusResult& result, const DaidalusJobStats& stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        delivered[job.ownshipId()].push_back(results(job,result));
+      });
+      for (int k = 0; k < (int) jobs.size(); ++k) {
+        service.submit(jobs[k]);
+      }
+      service.wait();
+    }
+    std::map<std::string,int> next;
+    for (int k = 0; k < (int) jobs.size(); ++k) {
+      const std::vector<std::string>& got = delivered[jobs[k].ownshipId()];
+      int i = next[jobs[k].ownshipId()]++;
+      if ((i >= (int) got.size() || got[i] != expected[k]) && check.fail()) {
+        std::printf("%d workers: job %d of %s differs from direct computation\n",workers[w],i,
+            jobs[k].ownshipId().c_str());
+      }
+    }
+  }
+  std::printf("%d/%d jobs have results that depend on the wind\n",windy,(int) jobs.size());
+  if (windy == 0 && check.fail()) {
+    std::printf("no job depends on the wind\n");
+  }
+  for (int w = 0; w < 3; ++w) {
+    DaidalusService service(prototype,workers[w],
+        [](const DaidalusJob& job, DaidalusResult& result, const DaidalusJobStats& stats) {
+      if (job.getTime() == 1) {
+        throw std::runtime_error("callback failure");
+      }
+    });
+    for (int k = 0; k < (int) jobs.size(); ++k) {
+      service.submit(jobs[k]);
+    }
+    service.wait();
+    if ((service.completedJobs() != (long) jobs.size() || !service.hasError()) && check.fail()) {
+      std::printf("%d workers: %ld jobs completed when callbacks throw, %s error\n",workers[w],service.completedJobs(),
+          service.hasError() ? "with" : "without");
+    }
+  }
+  return check.result();
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2015 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+/*
+ * Checks that the optimized paths of TCAS3D give the same results as the reference computations, on
+ * random encounters, with and without the HMD filter:
+ * - conflict, which uses RA3D_conflict, against RA3D(...).conflict(),
+ * - anyViolation, which filters blocks of traffic, against violation on each aircraft,
+ * - anyConflict, which filters blocks of traffic, against RA3D(...).conflict() on each aircraft.
+ */
+
+#include "TCAS3D.h"
+#include "TCASTable.h"
+#include "TrafficArrays.h"
+#include "Vect3.h"
+#include "Velocity.h"
+#include "Check.h"
+#include <cstdio>
+
+using namespace larcfm;
+
+// Random relative position and velocity of a traffic aircraft, with some level and some stationary aircraft
+static void encounter(int i, Vect3& s, Velocity& v) {
+  s = Vect3(uniform(-15000,15000),uniform(-15000,15000),uniform(-1500,1500));
+  double vz = i%7 == 0 ? 0 : uniform(-30,30);
+  v = i%11 == 0 ? Velocity::mkVxyz(0,0,vz) : Velocity::mkVxyz(uniform(-250,250),uniform(-250,250),vz);
+}
+
+int main(int argc, char* argv[]) {
+  Check check("TCAS3DParity",11);
+  int pairs = 100000;
+  int batches = 2000;
+  int n = 20;
+  Velocity vo = Velocity::mkVxyz(120,10,0);
+  for (int hmdf = 0; hmdf < 2; ++hmdf) {
+    TCAS3D tcas;
+    TCASTable table(true);
+    table.setHMDFilter(hmdf == 1);
+    tcas.setTCASTable(table);
+    int conflicts = 0;
+    for (int i = 0; i < pairs; ++i) {
+      Vect3 so(0,0,100+(i%40)*300);
+      Vect3 s;
+      Velocity vi;
+      encounter(i,s,vi);
+      Vect3 si = s.Add(so);
+      double B = (i%3)*5;
+      double T = i%5 == 0 ? 0 : 60+i%60;
+      bool fast = tcas.conflict(so,vo,si,vi,B,T);
+      bool ref = tcas.RA3D(so,vo,si,vi,B,T).conflict();
+      conflicts += ref;
+      if (fast != ref && check.fail()) {
+        std::printf("conflict: pair %d, HMD filter %d: %d, expected %d\n",i,hmdf,fast,ref);
+      }
+    }
+    int violations = 0;
+    int batch_conflicts = 0;
+    TrafficArrays traffic;
+    for (int k = 0; k < batches; ++k) {
+      Vect3 so(0,0,100+(k%40)*300);
+      traffic.clear();
+      for (int j = 0; j < n; ++j) {
+        Vect3 s;
+        Velocity vi;
+        encounter(j,s,vi);
+        s = s.Scal(2).Add(so);
+        traffic.sx.push_back(s.x);
+        traffic.sy.push_back(s.y);
+        traffic.sz.push_back(s.z);
+        traffic.vx.push_back(vi.x);
+        traffic.vy.push_back(vi.y);
+        traffic.vz.push_back(vi.z);
+      }
+      for (int rep = 0; rep < 5; ++rep) {
+        double t = rep*2.0;
+        double B = rep;
+        double T = 40+rep*10;
+        bool anyv = false;
+        bool anyc = false;
+        for (int j = 0; j < n; ++j) {
+          Velocity vi = traffic.v(j);
+          Vect3 si = vi.ScalAdd(t,traffic.s(j));
+          anyv = anyv || tcas.violation(so,vo,si,vi);
+          anyc = anyc || tcas.RA3D(so,vo,si,vi,B,T).conflict();
+        }
+        violations += anyv;
+        batch_conflicts += anyc;
+        if ((tcas.anyViolation(so,vo,traffic,t) != anyv || tcas.anyConflict(so,vo,traffic,t,B,T) != anyc) &&
+            check.fail()) {
+          std::printf("batch %d, time %g, HMD filter %d: anyViolation %d, anyConflict %d, expected %d %d\n",k,t,hmdf,
+              tcas.anyViolation(so,vo,traffic,t),tcas.anyConflict(so,vo,traffic,t,B,T),anyv,anyc);
+        }
+      }
+    }
+    std::printf("HMD filter %d: %d/%d pairs in conflict, %d/%d batches in violation, %d/%d batches in conflict\n",
+        hmdf,conflicts,pairs,violations,5*batches,batch_conflicts,5*batches);
+  }
+  return check.result();
+}